@@ -6,26 +6,36 @@
 
 #include <linux/array_size.h>
 #include <linux/bitfield.h>
+#include <linux/delay.h>
 #include <linux/device.h>
 #include <linux/err.h>
 #include <linux/errno.h>
 #include <linux/i2c.h>
 #include <linux/io.h>
 #include <linux/kernel.h>
+#include <linux/kthread.h>
+#include <linux/ktime.h>
 #include <linux/math64.h>
 #include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/pm_runtime.h>
 #include <linux/property.h>
+#include <linux/regulator/consumer.h>
+#include <linux/sysfs.h>
 #include <linux/units.h>
 
 #include <linux/iio/buffer.h>
 #include <linux/iio/iio.h>
+#include <linux/iio/sysfs.h>
 #include <linux/iio/trigger_consumer.h>
 #include <linux/iio/triggered_buffer.h>
 
 #include "abp060mg.h"
 
 #define ABP_ERROR_MASK        GENMASK(7, 6)
+#define ABP_STATUS_STALE      2
 #define ABP_TEMPERATURE_MASK  GENMASK(15, 5)
+#define ABP_TEMPERATURE8_MASK GENMASK(15, 8)
 #define ABP_PRESSURE_MASK     GENMASK(29, 16)
 
 struct abp_config {
@@ -90,7 +100,7 @@ static const struct abp_func_spec abp_func_spec[4] = {
 			    .capabilities = ABP_CAP_TEMP }
 };
 
-static const struct iio_chan_spec abp060mg_p_channel[] = {
+const struct iio_chan_spec abp060mg_p_channel[ABP_P_NUM_CHANNELS] = {
 	{
 		.type = IIO_PRESSURE,
 		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
@@ -106,8 +116,9 @@ static const struct iio_chan_spec abp060mg_p_channel[] = {
 	},
 	IIO_CHAN_SOFT_TIMESTAMP(1),
 };
+EXPORT_SYMBOL_NS(abp060mg_p_channel, IIO_HONEYWELL_ABP060MG);
 
-static const struct iio_chan_spec abp060mg_pt_channel[] = {
+const struct iio_chan_spec abp060mg_pt_channel[ABP_PT_NUM_CHANNELS] = {
 	{
 		.type = IIO_PRESSURE,
 		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
@@ -138,16 +149,65 @@ static const struct iio_chan_spec abp060mg_pt_channel[] = {
 	},
 	IIO_CHAN_SOFT_TIMESTAMP(2),
 };
+EXPORT_SYMBOL_NS(abp060mg_pt_channel, IIO_HONEYWELL_ABP060MG);
+
+/* 3 byte transfers, only the upper 8 bits of the temperature are read */
+const struct iio_chan_spec abp060mg_pt8_channel[ABP_PT_NUM_CHANNELS] = {
+	{
+		.type = IIO_PRESSURE,
+		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
+				      BIT(IIO_CHAN_INFO_SCALE) |
+				      BIT(IIO_CHAN_INFO_OFFSET),
+		.scan_index = 0,
+		.scan_type = {
+			.sign = 'u',
+			.realbits = 14,
+			.storagebits = 16,
+			.shift = 0,
+			.endianness = IIO_BE,
+		},
+	},
+	{
+		.type = IIO_TEMP,
+		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
+				      BIT(IIO_CHAN_INFO_SCALE) |
+				      BIT(IIO_CHAN_INFO_OFFSET),
+		.scan_index = 1,
+		.scan_type = {
+			.sign = 'u',
+			.realbits = 8,
+			.storagebits = 16,
+			.shift = 8,
+			.endianness = IIO_BE,
+		},
+	},
+	IIO_CHAN_SOFT_TIMESTAMP(2),
+};
+EXPORT_SYMBOL_NS(abp060mg_pt8_channel, IIO_HONEYWELL_ABP060MG);
 
 static bool abp060mg_conversion_is_valid(struct abp_state *state)
 {
 	return !(state->buffer[0] & ABP_ERROR_MASK);
 }
 
+/*
+ * conversions are stale or invalid until the startup time has passed since
+ * vdd was enabled, the first reads wait for the sensor instead of failing
+ */
+static void abp060mg_wait_ready(struct abp_state *state)
+{
+	s64 remaining = ktime_us_delta(state->ready_time, ktime_get());
+
+	if (remaining > 0)
+		fsleep(remaining);
+}
+
 static int abp060mg_get_measurement(struct abp_state *state)
 {
 	int ret;
 
+	abp060mg_wait_ready(state);
+
 	ret = state->recv_cb(state);
 	if (ret < 0)
 		return ret;
@@ -159,23 +219,132 @@ static int abp060mg_get_measurement(struct abp_state *state)
 	return 0;
 }
 
-static irqreturn_t abp_trigger_handler(int irq, void *private)
+/*
+ * a trigger that fires faster than the sensor updates its output finds a
+ * stale conversion. the output is read again until a new conversion shows up
+ * or the retry budget is spent. sleep mode parts start a new conversion with
+ * every read request, so only the others skip the response time delay.
+ * Context: state->lock must be held
+ */
+static int abp060mg_get_fresh_measurement(struct abp_state *state)
 {
-	struct iio_poll_func *pf = private;
-	struct iio_dev *indio_dev = pf->indio_dev;
-	struct abp_state *state = iio_priv(indio_dev);
+	ktime_t deadline;
+	unsigned int retries = 0;
 	int ret;
 
 	ret = abp060mg_get_measurement(state);
+	if (ret != -EAGAIN || !state->retry_max)
+		goto out;
+
+	deadline = ktime_add_us(ktime_get(), state->retry_us);
+	state->polling = !(state->func_spec->capabilities & ABP_CAP_SLEEP);
+	while (ret == -EAGAIN && retries < state->retry_max &&
+	       FIELD_GET(ABP_ERROR_MASK, state->buffer[0]) == ABP_STATUS_STALE &&
+	       ktime_before(ktime_get(), deadline)) {
+		usleep_range(ABP_UPDATE_PERIOD_US / 4, ABP_UPDATE_PERIOD_US / 2);
+		ret = abp060mg_get_measurement(state);
+		retries++;
+	}
+	state->polling = false;
+
+	state->retry_stats.reads += retries;
+	if (!ret && retries)
+		state->retry_stats.recovered++;
+out:
+	if (ret == -EAGAIN)
+		state->retry_stats.dropped++;
+
+	return ret;
+}
+
+static void abp_capture(struct iio_dev *indio_dev)
+{
+	struct abp_state *state = iio_priv(indio_dev);
+	int ret;
+
+	mutex_lock(&state->lock);
+	ret = abp060mg_get_fresh_measurement(state);
 	if (!ret) {
 		iio_push_to_buffers_with_timestamp(indio_dev, &state->buffer,
 						   iio_get_time_ns(indio_dev));
 	}
+	mutex_unlock(&state->lock);
 	iio_trigger_notify_done(indio_dev->trig);
+}
+
+static void abp_rt_work(struct kthread_work *work)
+{
+	struct abp_state *state = container_of(work, struct abp_state,
+					       rt.work);
+
+	abp_capture(state->indio_dev);
+}
+
+/*
+ * the top half queues the acquisition on the real-time capture thread (if
+ * one is running) straight from the trigger's hard irq, skipping the wakeup
+ * of the pollfunc irq thread.
+ */
+static irqreturn_t abp_trigger_top_half(int irq, void *private)
+{
+	struct iio_poll_func *pf = private;
+	struct abp_state *state = iio_priv(pf->indio_dev);
+
+	if (!iio_rt_capture_queue(&state->rt))
+		return IRQ_WAKE_THREAD;
 
 	return IRQ_HANDLED;
 }
 
+static irqreturn_t abp_trigger_handler(int irq, void *private)
+{
+	struct iio_poll_func *pf = private;
+	struct iio_dev *indio_dev = pf->indio_dev;
+	struct abp_state *state = iio_priv(indio_dev);
+
+	/* reached directly by nested triggers, the top half is skipped */
+	if (iio_rt_capture_queue(&state->rt))
+		return IRQ_HANDLED;
+
+	abp_capture(indio_dev);
+
+	return IRQ_HANDLED;
+}
+
+static int abp_buffer_preenable(struct iio_dev *indio_dev)
+{
+	struct abp_state *state = iio_priv(indio_dev);
+	int ret;
+
+	/* the sensor stays powered while the buffer is enabled */
+	ret = pm_runtime_resume_and_get(state->dev);
+	if (ret)
+		return ret;
+
+	ret = iio_rt_capture_start(&state->rt, state->dev);
+	if (ret)
+		pm_runtime_put_autosuspend(state->dev);
+
+	return ret;
+}
+
+static int abp_buffer_postdisable(struct iio_dev *indio_dev)
+{
+	struct abp_state *state = iio_priv(indio_dev);
+
+	iio_rt_capture_stop(&state->rt);
+
+	pm_runtime_mark_last_busy(state->dev);
+	pm_runtime_put_autosuspend(state->dev);
+
+	return 0;
+}
+
+static const struct iio_buffer_setup_ops abp_buffer_setup_ops = {
+	.preenable = abp_buffer_preenable,
+	.postdisable = abp_buffer_postdisable,
+};
+
 /*
  * IIO ABI expects
  * value = (conv + offset) * scale
@@ -189,6 +358,10 @@ static irqreturn_t abp_trigger_handler(int irq, void *private)
  *  scale = a * 1000 = .097703957 * 1000 = 97.703957
  *  offset = b/a = -50 / .097703957 = -50000000 / 97704
  *
+ *  an 8 bit temperature is conv >> 3, hence
+ *  scale = 8 * a * 1000 = 781.631656
+ *  offset = -50 / (8 * a) = -2047 / 32
+ *
  *  based on the datasheet
  *  pressure = (conv - Omin) * Q + Pmin =
  *          ((conv - Omin) + Pmin/Q) * Q
@@ -206,16 +379,26 @@ static int abp060mg_read_raw(struct iio_dev *indio_dev,
 
 	switch (mask) {
 	case IIO_CHAN_INFO_RAW:
-		ret = abp060mg_get_measurement(state);
+		ret = pm_runtime_resume_and_get(state->dev);
 		if (ret)
 			return ret;
+		mutex_lock(&state->lock);
+		ret = abp060mg_get_measurement(state);
 		recvd = get_unaligned_be32(state->buffer);
+		mutex_unlock(&state->lock);
+		pm_runtime_mark_last_busy(state->dev);
+		pm_runtime_put_autosuspend(state->dev);
+		if (ret)
+			return ret;
 		switch (chan->type) {
 		case IIO_PRESSURE:
 			*val = FIELD_GET(ABP_PRESSURE_MASK, recvd);
 			return IIO_VAL_INT;
 		case IIO_TEMP:
-			*val = FIELD_GET(ABP_TEMPERATURE_MASK, recvd);
+			if (state->temp_bits == 8)
+				*val = FIELD_GET(ABP_TEMPERATURE8_MASK, recvd);
+			else
+				*val = FIELD_GET(ABP_TEMPERATURE_MASK, recvd);
 			return IIO_VAL_INT;
 		default:
 			return -EINVAL;
@@ -223,8 +406,13 @@ static int abp060mg_read_raw(struct iio_dev *indio_dev,
 	case IIO_CHAN_INFO_OFFSET:
 		switch (chan->type) {
 		case IIO_TEMP:
-			*val = -50000000;
-			*val2 = 97704;
+			if (state->temp_bits == 8) {
+				*val = -2047;
+				*val2 = 32;
+			} else {
+				*val = -50000000;
+				*val2 = 97704;
+			}
 			return IIO_VAL_FRACTIONAL;
 		case IIO_PRESSURE:
 			*val = state->p_offset;
@@ -237,8 +425,13 @@ static int abp060mg_read_raw(struct iio_dev *indio_dev,
 	case IIO_CHAN_INFO_SCALE:
 		switch (chan->type) {
 		case IIO_TEMP:
-			*val = 97;
-			*val2 = 703957;
+			if (state->temp_bits == 8) {
+				*val = 781;
+				*val2 = 631656;
+			} else {
+				*val = 97;
+				*val2 = 703957;
+			}
 			return IIO_VAL_INT_PLUS_MICRO;
 		case IIO_PRESSURE:
 			*val = state->p_scale;
@@ -256,8 +449,203 @@ static int abp060mg_read_raw(struct iio_dev *indio_dev,
 	return ret;
 }
 
+static ssize_t stale_retry_count_show(struct device *dev,
+				      struct device_attribute *attr, char *buf)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", READ_ONCE(state->retry_max));
+}
+
+static ssize_t stale_retry_count_store(struct device *dev,
+				       struct device_attribute *attr,
+				       const char *buf, size_t len)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+	u32 count;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &count);
+	if (ret)
+		return ret;
+
+	WRITE_ONCE(state->retry_max, count);
+
+	return len;
+}
+
+static ssize_t stale_retry_us_show(struct device *dev,
+				   struct device_attribute *attr, char *buf)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", READ_ONCE(state->retry_us));
+}
+
+static ssize_t stale_retry_us_store(struct device *dev,
+				    struct device_attribute *attr,
+				    const char *buf, size_t len)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+	u32 budget;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &budget);
+	if (ret)
+		return ret;
+
+	if (budget > USEC_PER_SEC)
+		return -EINVAL;
+
+	WRITE_ONCE(state->retry_us, budget);
+
+	return len;
+}
+
+static ssize_t stale_retries_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", READ_ONCE(state->retry_stats.reads));
+}
+
+static ssize_t stale_recovered_show(struct device *dev,
+				    struct device_attribute *attr, char *buf)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n",
+			  READ_ONCE(state->retry_stats.recovered));
+}
+
+static ssize_t stale_dropped_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", READ_ONCE(state->retry_stats.dropped));
+}
+
+/*
+ * a burst returns consecutive pressure conversions out of a single sysfs
+ * read, acquired by the same loop as the stale retries. sleep mode parts
+ * start a new conversion with every read request and keep the response time
+ * delay, the others are polled until their output is no longer stale. every
+ * line holds the timestamp taken right before the transfer and the raw
+ * pressure.
+ */
+static int abp060mg_get_burst(struct abp_state *state, char *buf)
+{
+	u32 burst_len = READ_ONCE(state->burst_len);
+	unsigned int count = 0;
+	ktime_t deadline;
+	s64 timestamp;
+	u32 recvd;
+	int len = 0;
+	int ret;
+
+	mutex_lock(&state->lock);
+	state->polling = !(state->func_spec->capabilities & ABP_CAP_SLEEP);
+	deadline = ktime_add_us(ktime_get(), ABP_BURST_TIMEOUT_US);
+	for (;;) {
+		timestamp = iio_get_time_ns(state->indio_dev);
+		ret = abp060mg_get_measurement(state);
+		if (!ret) {
+			recvd = get_unaligned_be32(state->buffer);
+			len += sysfs_emit_at(buf, len, "%lld %lu\n", timestamp,
+					     FIELD_GET(ABP_PRESSURE_MASK, recvd));
+			deadline = ktime_add_us(ktime_get(),
+						ABP_BURST_TIMEOUT_US);
+			if (++count == burst_len)
+				break;
+		} else if (ret != -EAGAIN ||
+			   FIELD_GET(ABP_ERROR_MASK, state->buffer[0]) !=
+				ABP_STATUS_STALE) {
+			break;
+		} else if (ktime_after(ktime_get(), deadline)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+		if (state->polling)
+			usleep_range(ABP_UPDATE_PERIOD_US / 4,
+				     ABP_UPDATE_PERIOD_US / 2);
+	}
+	state->polling = false;
+	mutex_unlock(&state->lock);
+
+	return ret ?: len;
+}
+
+static ssize_t in_pressure_raw_burst_show(struct device *dev,
+					  struct device_attribute *attr,
+					  char *buf)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct abp_state *state = iio_priv(indio_dev);
+	int ret;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	ret = pm_runtime_resume_and_get(state->dev);
+	if (!ret) {
+		ret = abp060mg_get_burst(state, buf);
+		pm_runtime_mark_last_busy(state->dev);
+		pm_runtime_put_autosuspend(state->dev);
+	}
+	iio_device_release_direct_mode(indio_dev);
+
+	return ret;
+}
+
+static ssize_t in_pressure_raw_burst_store(struct device *dev,
+					   struct device_attribute *attr,
+					   const char *buf, size_t len)
+{
+	struct abp_state *state = iio_priv(dev_to_iio_dev(dev));
+	u32 count;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &count);
+	if (ret)
+		return ret;
+
+	if (!count || count > ABP_BURST_MAX)
+		return -EINVAL;
+
+	WRITE_ONCE(state->burst_len, count);
+
+	return len;
+}
+
+IIO_RT_CAPTURE_DEVICE_ATTRS(struct abp_state, rt);
+static IIO_DEVICE_ATTR_RW(in_pressure_raw_burst, 0);
+static IIO_DEVICE_ATTR_RW(stale_retry_count, 0);
+static IIO_DEVICE_ATTR_RW(stale_retry_us, 0);
+static IIO_DEVICE_ATTR_RO(stale_retries, 0);
+static IIO_DEVICE_ATTR_RO(stale_recovered, 0);
+static IIO_DEVICE_ATTR_RO(stale_dropped, 0);
+
+static struct attribute *abp060mg_attrs[] = {
+	IIO_RT_CAPTURE_ATTRS,
+	&iio_dev_attr_in_pressure_raw_burst.dev_attr.attr,
+	&iio_dev_attr_stale_retry_count.dev_attr.attr,
+	&iio_dev_attr_stale_retry_us.dev_attr.attr,
+	&iio_dev_attr_stale_retries.dev_attr.attr,
+	&iio_dev_attr_stale_recovered.dev_attr.attr,
+	&iio_dev_attr_stale_dropped.dev_attr.attr,
+	NULL
+};
+
+static const struct attribute_group abp060mg_attr_group = {
+	.attrs = abp060mg_attrs,
+};
+
 static const struct iio_info abp060mg_info = {
 	.read_raw = abp060mg_read_raw,
+	.attrs = &abp060mg_attr_group,
 };
 
 static void abp060mg_init_attributes(struct abp_state *state)
@@ -276,6 +664,53 @@ static void abp060mg_init_attributes(struct abp_state *state)
 	state->p_offset = div_s64_rem(tmp, MICRO, &state->p_offset_dec);
 }
 
+/*
+ * runtime suspend switches off vdd, the startup time is waited for again via
+ * ready_time after resume. sleep mode parts still get a measurement request
+ * for every conversion since they go back to sleep on their own, the
+ * autosuspend delay only spares closely spaced reads the power-up time.
+ */
+static int abp060mg_runtime_suspend(struct device *dev)
+{
+	struct abp_state *state = iio_priv(dev_get_drvdata(dev));
+
+	return regulator_disable(state->vdd);
+}
+
+static int abp060mg_runtime_resume(struct device *dev)
+{
+	struct abp_state *state = iio_priv(dev_get_drvdata(dev));
+	int ret;
+
+	ret = regulator_enable(state->vdd);
+	if (ret)
+		return ret;
+
+	state->ready_time = ktime_add_us(ktime_get(), ABP_STARTUP_TIME_US);
+
+	return 0;
+}
+
+EXPORT_NS_RUNTIME_DEV_PM_OPS(abp060mg_pm_ops, abp060mg_runtime_suspend,
+			     abp060mg_runtime_resume, NULL,
+			     IIO_HONEYWELL_ABP060MG);
+
+static void abp060mg_vdd_disable(void *arg)
+{
+	regulator_disable(arg);
+}
+
+/* resume first so vdd is enabled when abp060mg_vdd_disable() runs */
+static void abp060mg_pm_disable(void *arg)
+{
+	struct device *dev = arg;
+
+	pm_runtime_get_sync(dev);
+	pm_runtime_put_noidle(dev);
+	pm_runtime_disable(dev);
+	pm_runtime_dont_use_autosuspend(dev);
+}
+
 int abp060mg_common_probe(struct device *dev, abp_recv_fn recv, const u32 type,
 		     const char *name, const u32 flags)
 {
@@ -290,7 +725,13 @@ int abp060mg_common_probe(struct device *dev, abp_recv_fn recv, const u32 type,
 
 	state = iio_priv(indio_dev);
 	state->recv_cb = recv;
+	mutex_init(&state->lock);
 	state->dev = dev;
+	state->indio_dev = indio_dev;
+	state->retry_max = ABP_RETRY_MAX;
+	state->retry_us = ABP_RETRY_US;
+	state->burst_len = 1;
+	iio_rt_capture_init(&state->rt, abp_rt_work);
 
 	if (flags & ABP_FLAG_MREQ)
 		state->mreq_len = 1;
@@ -321,11 +762,38 @@ int abp060mg_common_probe(struct device *dev, abp_recv_fn recv, const u32 type,
 
 	abp060mg_init_attributes(state);
 
+	state->vdd = devm_regulator_get(dev, "vdd");
+	if (IS_ERR(state->vdd))
+		return dev_err_probe(dev, PTR_ERR(state->vdd),
+				     "can't get vdd supply\n");
+
+	ret = regulator_enable(state->vdd);
+	if (ret)
+		return dev_err_probe(dev, ret, "can't enable vdd supply\n");
+	state->ready_time = ktime_add_us(ktime_get(), ABP_STARTUP_TIME_US);
+
+	ret = devm_add_action_or_reset(dev, abp060mg_vdd_disable, state->vdd);
+	if (ret)
+		return ret;
+
 	indio_dev->name = name;
 	indio_dev->modes = INDIO_DIRECT_MODE;
 	indio_dev->info = &abp060mg_info;
 
-	if (state->func_spec->capabilities & ABP_CAP_TEMP) {
+	state->temp_bits = 11;
+	device_property_read_u32(dev, "honeywell,temperature-bits",
+				 &state->temp_bits);
+	if (state->temp_bits != 8 && state->temp_bits != 11)
+		return dev_err_probe(dev, -EINVAL,
+				     "honeywell,temperature-bits %u invalid\n",
+				     state->temp_bits);
+
+	if (state->func_spec->capabilities & ABP_CAP_TEMP &&
+	    state->temp_bits == 8) {
+		indio_dev->channels = abp060mg_pt8_channel;
+		indio_dev->num_channels = ARRAY_SIZE(abp060mg_pt8_channel);
+		state->read_len = 3;
+	} else if (state->func_spec->capabilities & ABP_CAP_TEMP) {
 		indio_dev->channels = abp060mg_pt_channel;
 		indio_dev->num_channels = ARRAY_SIZE(abp060mg_pt_channel);
 		state->read_len = 4;
@@ -335,8 +803,22 @@ int abp060mg_common_probe(struct device *dev, abp_recv_fn recv, const u32 type,
 		state->read_len = 2;
 	}
 
-	ret = devm_iio_triggered_buffer_setup(dev, indio_dev, NULL,
-					      abp_trigger_handler, NULL);
+	ret = devm_iio_triggered_buffer_setup(dev, indio_dev,
+					      abp_trigger_top_half,
+					      abp_trigger_handler,
+					      &abp_buffer_setup_ops);
+	if (ret)
+		return ret;
+
+	dev_set_drvdata(dev, indio_dev);
+	pm_runtime_get_noresume(dev);
+	pm_runtime_set_active(dev);
+	pm_runtime_enable(dev);
+	pm_runtime_set_autosuspend_delay(dev, ABP_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(dev);
+	pm_runtime_put(dev);
+
+	ret = devm_add_action_or_reset(dev, abp060mg_pm_disable, dev);
 	if (ret)
 		return ret;
 
@@ -347,3 +829,4 @@ EXPORT_SYMBOL_NS(abp060mg_common_probe, IIO_HONEYWELL_ABP060MG);
 MODULE_AUTHOR("Marcin Malagowski <mrc@bourne.st>");
 MODULE_DESCRIPTION("Honeywell ABP pressure sensor driver");
 MODULE_LICENSE("GPL");
+MODULE_IMPORT_NS(IIO_RT_CAPTURE);
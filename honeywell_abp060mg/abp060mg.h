@@ -8,13 +8,27 @@
 #ifndef _ABP060MG_H
 #define _ABP060MG_H
 
+#include <linux/ktime.h>
+#include <linux/mutex.h>
 #include <linux/stddef.h>
 #include <linux/types.h>
 
 #include <linux/iio/iio.h>
 
+#include "../iio_rt_capture/iio_rt_capture.h"
+
 #define ABP_MAX_READ_SIZE 4
 #define ABP_RESP_TIME_MS  2
+#define ABP_STARTUP_TIME_US 3000
+#define ABP_UPDATE_PERIOD_US 460
+#define ABP_RETRY_MAX       4
+#define ABP_RETRY_US        1000
+#define ABP_AUTOSUSPEND_DELAY_MS 1000
+#define ABP_BURST_MAX       64
+#define ABP_BURST_TIMEOUT_US 5000
+
+#define ABP_P_NUM_CHANNELS  2 /* pressure, timestamp */
+#define ABP_PT_NUM_CHANNELS 3 /* pressure, temperature, timestamp */
 
 /* flags accepted as argument to abp060mg_common_probe() */
 #define ABP_FLAG_NULL     0
@@ -25,6 +39,8 @@
 #define ABP_CAP_SLEEP     0x02 /* sensor needs to be woken up */
 
 struct device;
+struct dev_pm_ops;
+struct regulator;
 
 struct iio_chan_spec;
 struct iio_dev;
@@ -50,33 +66,64 @@ enum abp_variant {
 /**
  * struct abp_state
  * @dev: current device structure
+ * @indio_dev: iio device this structure is private to
  * @func_spec: transfer function specification
  * @recv_cb: function that implements the chip reads
+ * @lock: serializes the transfers and protects @buffer and @polling
+ * @vdd: power supply, switched off while the device is runtime suspended
  * @is_valid: true if last transfer has been validated
  * @mreq_len: measure request - 1 if one dummy byte needs to be sent to wake up
  *             sensor
  * @read_len: number of bytes to be read from sensor
+ * @temp_bits: temperature resolution, either 8 or 11 bits
  * @pmin: minimum measurable pressure limit
  * @pmax: maximum measurable pressure limit
  * @p_scale: pressure scale
  * @p_scale_dec: pressure scale, decimal places
  * @p_offset: pressure offset
  * @p_offset_dec: pressure offset, decimal places
+ * @ready_time: time after which the sensor provides valid conversions
+ * @polling: skip the response time delay of the bus drivers, the stale flag
+ *           is used instead to tell if a conversion is new
+ * @retry_max: re-reads allowed when a triggered read finds a stale
+ *             conversion, 0 to drop the sample right away
+ * @retry_us: time budget for the re-reads of one triggered read
+ * @retry_stats: counters of the stale retries, only updated by the trigger
+ * @retry_stats.reads: re-reads done
+ * @retry_stats.recovered: samples delivered thanks to a re-read
+ * @retry_stats.dropped: samples lost after the budget was spent
+ * @burst_len: number of pressure samples returned by a burst read
+ * @rt: real-time capture thread
  * @buffer: raw conversion data
  */
 struct abp_state {
 	struct device *dev;
+	struct iio_dev *indio_dev;
 	const struct abp_func_spec *func_spec;
 	abp_recv_fn recv_cb;
+	struct mutex lock;
+	struct regulator *vdd;
 	bool is_valid;
 	int mreq_len;
 	u8 read_len;
+	u32 temp_bits;
 	s32 pmin;
 	s32 pmax;
 	s64 p_scale;
 	s64 p_scale_dec;
 	s64 p_offset;
 	s32 p_offset_dec;
+	ktime_t ready_time;
+	bool polling;
+	u32 retry_max;
+	u32 retry_us;
+	struct {
+		unsigned long reads;
+		unsigned long recovered;
+		unsigned long dropped;
+	} retry_stats;
+	u32 burst_len;
+	struct iio_rt_capture rt;
 	u8 buffer[16] __aligned(IIO_DMA_MINALIGN);
 };
 
@@ -86,6 +133,12 @@ struct abp_func_spec {
 	u16 capabilities;
 };
 
+extern const struct iio_chan_spec abp060mg_p_channel[ABP_P_NUM_CHANNELS];
+extern const struct iio_chan_spec abp060mg_pt_channel[ABP_PT_NUM_CHANNELS];
+extern const struct iio_chan_spec abp060mg_pt8_channel[ABP_PT_NUM_CHANNELS];
+
+extern const struct dev_pm_ops abp060mg_pm_ops;
+
 int abp060mg_common_probe(struct device *dev, abp_recv_fn recv, const u32 type,
 			  const char *name, const u32 flags);
 
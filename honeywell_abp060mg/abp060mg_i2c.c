@@ -12,6 +12,7 @@
 #include <linux/i2c.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
+#include <linux/pm.h>
 #include <linux/types.h>
 
 #include "abp060mg.h"
@@ -43,7 +44,8 @@ static int abp060mg_i2c_recv(struct abp_state *state)
 			return ret;
 	}
 
-	msleep_interruptible(ABP_RESP_TIME_MS);
+	if (!state->polling)
+		msleep_interruptible(ABP_RESP_TIME_MS);
 
 	msg.addr = client->addr;
 	msg.flags = client->flags | I2C_M_RD;
@@ -123,6 +125,7 @@ MODULE_DEVICE_TABLE(i2c, abp060mg_i2c_id_table);
 static struct i2c_driver abp060mg_i2c_driver = {
 	.driver = {
 		.name = "abp060mg",
+		.pm = pm_ptr(&abp060mg_pm_ops),
 	},
 	.probe = abp060mg_i2c_probe,
 	.id_table = abp060mg_i2c_id_table,
@@ -13,6 +13,7 @@
 #include <linux/errno.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
+#include <linux/pm.h>
 #include <linux/spi/spi.h>
 #include <linux/types.h>
 
@@ -55,7 +56,8 @@ static int abp060mg_spi_recv(struct abp_state *state)
 		spi->cs_setup.unit = orig_cs_setup_unit;
 	}
 
-	msleep_interruptible(ABP_RESP_TIME_MS);
+	if (!state->polling)
+		msleep_interruptible(ABP_RESP_TIME_MS);
 
 	xfer.rx_buf = state->buffer;
 	xfer.len = state->read_len;
@@ -122,6 +124,7 @@ MODULE_DEVICE_TABLE(spi, abp060mg_spi_id_table);
 static struct spi_driver abp060mg_spi_driver = {
 	.driver = {
 		.name = "abp060mg",
+		.pm = pm_ptr(&abp060mg_pm_ops),
 	},
 	.probe = abp060mg_spi_probe,
 	.id_table = abp060mg_spi_id_table,
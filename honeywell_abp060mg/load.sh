@@ -1,5 +1,6 @@
 #!/bin/bash
 
+insmod ../iio_rt_capture/iio_rt_capture.ko
 insmod abp060mg.ko
 insmod abp060mg_i2c.ko
 insmod abp060mg_spi.ko
@@ -3,4 +3,5 @@
 rmmod abp060mg_i2c
 rmmod abp060mg_spi
 rmmod abp060mg
+rmmod iio_rt_capture
 
@@ -9,16 +9,27 @@
 
 #include <linux/array_size.h>
 #include <linux/bitfield.h>
+#include <linux/bitops.h>
 #include <linux/bits.h>
 #include <linux/cleanup.h>
+#include <linux/delay.h>
 #include <linux/init.h>
+#include <linux/kthread.h>
+#include <linux/list.h>
+#include <linux/ktime.h>
 #include <linux/math64.h>
+#include <linux/minmax.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/pm_runtime.h>
 #include <linux/printk.h>
 #include <linux/property.h>
+#include <linux/seqlock.h>
 #include <linux/regulator/consumer.h>
+#include <linux/slab.h>
 #include <linux/string.h>
+#include <linux/sysfs.h>
 #include <linux/types.h>
 #include <linux/units.h>
 
@@ -31,6 +42,7 @@
 #include <asm/unaligned.h>
 
 #include "hsc030pa.h"
+#include "hsc030pa_variants.h"
 
 /*
  * HSC_PRESSURE_TRIPLET_LEN - length for the string that defines the
@@ -39,234 +51,35 @@
  */
 #define HSC_PRESSURE_TRIPLET_LEN 6
 #define HSC_STATUS_MASK          GENMASK(7, 6)
+#define HSC_STATUS_VALID         0
+#define HSC_STATUS_STALE         2
 #define HSC_TEMPERATURE_MASK     GENMASK(15, 5)
+#define HSC_TEMPERATURE8_MASK    GENMASK(15, 8)
 #define HSC_PRESSURE_MASK        GENMASK(29, 16)
-
-struct hsc_func_spec {
-	u32 output_min;
-	u32 output_max;
-};
-
-/*
- * function A: 10% - 90% of 2^14
- * function B:  5% - 95% of 2^14
- * function C:  5% - 85% of 2^14
- * function F:  4% - 94% of 2^14
- */
-static const struct hsc_func_spec hsc_func_spec[] = {
-	[HSC_FUNCTION_A] = { .output_min = 1638, .output_max = 14746 },
-	[HSC_FUNCTION_B] = { .output_min =  819, .output_max = 15565 },
-	[HSC_FUNCTION_C] = { .output_min =  819, .output_max = 13926 },
-	[HSC_FUNCTION_F] = { .output_min =  655, .output_max = 15401 },
-};
-
-enum hsc_variants {
-	HSC001BA = 0x00, HSC1_6BA = 0x01, HSC2_5BA = 0x02, HSC004BA = 0x03,
-	HSC006BA = 0x04, HSC010BA = 0x05, HSC1_6MD = 0x06, HSC2_5MD = 0x07,
-	HSC004MD = 0x08, HSC006MD = 0x09, HSC010MD = 0x0a, HSC016MD = 0x0b,
-	HSC025MD = 0x0c, HSC040MD = 0x0d, HSC060MD = 0x0e, HSC100MD = 0x0f,
-	HSC160MD = 0x10, HSC250MD = 0x11, HSC400MD = 0x12, HSC600MD = 0x13,
-	HSC001BD = 0x14, HSC1_6BD = 0x15, HSC2_5BD = 0x16, HSC004BD = 0x17,
-	HSC2_5MG = 0x18, HSC004MG = 0x19, HSC006MG = 0x1a, HSC010MG = 0x1b,
-	HSC016MG = 0x1c, HSC025MG = 0x1d, HSC040MG = 0x1e, HSC060MG = 0x1f,
-	HSC100MG = 0x20, HSC160MG = 0x21, HSC250MG = 0x22, HSC400MG = 0x23,
-	HSC600MG = 0x24, HSC001BG = 0x25, HSC1_6BG = 0x26, HSC2_5BG = 0x27,
-	HSC004BG = 0x28, HSC006BG = 0x29, HSC010BG = 0x2a, HSC100KA = 0x2b,
-	HSC160KA = 0x2c, HSC250KA = 0x2d, HSC400KA = 0x2e, HSC600KA = 0x2f,
-	HSC001GA = 0x30, HSC160LD = 0x31, HSC250LD = 0x32, HSC400LD = 0x33,
-	HSC600LD = 0x34, HSC001KD = 0x35, HSC1_6KD = 0x36, HSC2_5KD = 0x37,
-	HSC004KD = 0x38, HSC006KD = 0x39, HSC010KD = 0x3a, HSC016KD = 0x3b,
-	HSC025KD = 0x3c, HSC040KD = 0x3d, HSC060KD = 0x3e, HSC100KD = 0x3f,
-	HSC160KD = 0x40, HSC250KD = 0x41, HSC400KD = 0x42, HSC250LG = 0x43,
-	HSC400LG = 0x44, HSC600LG = 0x45, HSC001KG = 0x46, HSC1_6KG = 0x47,
-	HSC2_5KG = 0x48, HSC004KG = 0x49, HSC006KG = 0x4a, HSC010KG = 0x4b,
-	HSC016KG = 0x4c, HSC025KG = 0x4d, HSC040KG = 0x4e, HSC060KG = 0x4f,
-	HSC100KG = 0x50, HSC160KG = 0x51, HSC250KG = 0x52, HSC400KG = 0x53,
-	HSC600KG = 0x54, HSC001GG = 0x55, HSC015PA = 0x56, HSC030PA = 0x57,
-	HSC060PA = 0x58, HSC100PA = 0x59, HSC150PA = 0x5a, HSC0_5ND = 0x5b,
-	HSC001ND = 0x5c, HSC002ND = 0x5d, HSC004ND = 0x5e, HSC005ND = 0x5f,
-	HSC010ND = 0x60, HSC020ND = 0x61, HSC030ND = 0x62, HSC001PD = 0x63,
-	HSC005PD = 0x64, HSC015PD = 0x65, HSC030PD = 0x66, HSC060PD = 0x67,
-	HSC001NG = 0x68, HSC002NG = 0x69, HSC004NG = 0x6a, HSC005NG = 0x6b,
-	HSC010NG = 0x6c, HSC020NG = 0x6d, HSC030NG = 0x6e, HSC001PG = 0x6f,
-	HSC005PG = 0x70, HSC015PG = 0x71, HSC030PG = 0x72, HSC060PG = 0x73,
-	HSC100PG = 0x74, HSC150PG = 0x75, HSC_VARIANTS_MAX
-};
-
-static const char * const hsc_triplet_variants[HSC_VARIANTS_MAX] = {
-	[HSC001BA] = "001BA", [HSC1_6BA] = "1.6BA", [HSC2_5BA] = "2.5BA",
-	[HSC004BA] = "004BA", [HSC006BA] = "006BA", [HSC010BA] = "010BA",
-	[HSC1_6MD] = "1.6MD", [HSC2_5MD] = "2.5MD", [HSC004MD] = "004MD",
-	[HSC006MD] = "006MD", [HSC010MD] = "010MD", [HSC016MD] = "016MD",
-	[HSC025MD] = "025MD", [HSC040MD] = "040MD", [HSC060MD] = "060MD",
-	[HSC100MD] = "100MD", [HSC160MD] = "160MD", [HSC250MD] = "250MD",
-	[HSC400MD] = "400MD", [HSC600MD] = "600MD", [HSC001BD] = "001BD",
-	[HSC1_6BD] = "1.6BD", [HSC2_5BD] = "2.5BD", [HSC004BD] = "004BD",
-	[HSC2_5MG] = "2.5MG", [HSC004MG] = "004MG", [HSC006MG] = "006MG",
-	[HSC010MG] = "010MG", [HSC016MG] = "016MG", [HSC025MG] = "025MG",
-	[HSC040MG] = "040MG", [HSC060MG] = "060MG", [HSC100MG] = "100MG",
-	[HSC160MG] = "160MG", [HSC250MG] = "250MG", [HSC400MG] = "400MG",
-	[HSC600MG] = "600MG", [HSC001BG] = "001BG", [HSC1_6BG] = "1.6BG",
-	[HSC2_5BG] = "2.5BG", [HSC004BG] = "004BG", [HSC006BG] = "006BG",
-	[HSC010BG] = "010BG", [HSC100KA] = "100KA", [HSC160KA] = "160KA",
-	[HSC250KA] = "250KA", [HSC400KA] = "400KA", [HSC600KA] = "600KA",
-	[HSC001GA] = "001GA", [HSC160LD] = "160LD", [HSC250LD] = "250LD",
-	[HSC400LD] = "400LD", [HSC600LD] = "600LD", [HSC001KD] = "001KD",
-	[HSC1_6KD] = "1.6KD", [HSC2_5KD] = "2.5KD", [HSC004KD] = "004KD",
-	[HSC006KD] = "006KD", [HSC010KD] = "010KD", [HSC016KD] = "016KD",
-	[HSC025KD] = "025KD", [HSC040KD] = "040KD", [HSC060KD] = "060KD",
-	[HSC100KD] = "100KD", [HSC160KD] = "160KD", [HSC250KD] = "250KD",
-	[HSC400KD] = "400KD", [HSC250LG] = "250LG", [HSC400LG] = "400LG",
-	[HSC600LG] = "600LG", [HSC001KG] = "001KG", [HSC1_6KG] = "1.6KG",
-	[HSC2_5KG] = "2.5KG", [HSC004KG] = "004KG", [HSC006KG] = "006KG",
-	[HSC010KG] = "010KG", [HSC016KG] = "016KG", [HSC025KG] = "025KG",
-	[HSC040KG] = "040KG", [HSC060KG] = "060KG", [HSC100KG] = "100KG",
-	[HSC160KG] = "160KG", [HSC250KG] = "250KG", [HSC400KG] = "400KG",
-	[HSC600KG] = "600KG", [HSC001GG] = "001GG", [HSC015PA] = "015PA",
-	[HSC030PA] = "030PA", [HSC060PA] = "060PA", [HSC100PA] = "100PA",
-	[HSC150PA] = "150PA", [HSC0_5ND] = "0.5ND", [HSC001ND] = "001ND",
-	[HSC002ND] = "002ND", [HSC004ND] = "004ND", [HSC005ND] = "005ND",
-	[HSC010ND] = "010ND", [HSC020ND] = "020ND", [HSC030ND] = "030ND",
-	[HSC001PD] = "001PD", [HSC005PD] = "005PD", [HSC015PD] = "015PD",
-	[HSC030PD] = "030PD", [HSC060PD] = "060PD", [HSC001NG] = "001NG",
-	[HSC002NG] = "002NG", [HSC004NG] = "004NG", [HSC005NG] = "005NG",
-	[HSC010NG] = "010NG", [HSC020NG] = "020NG", [HSC030NG] = "030NG",
-	[HSC001PG] = "001PG", [HSC005PG] = "005PG", [HSC015PG] = "015PG",
-	[HSC030PG] = "030PG", [HSC060PG] = "060PG", [HSC100PG] = "100PG",
-	[HSC150PG] = "150PG",
-};
+#define HSC_DATA_CHANNELS        GENMASK(1, 0)
 
 /**
- * struct hsc_range_config - list of pressure ranges based on nomenclature
- * @pmin: lowest pressure that can be measured
- * @pmax: highest pressure that can be measured
+ * struct hsc_group - sensors on one bus that are acquired together
+ * @node: entry in hsc_groups
+ * @bus: parent device of the members, the i2c adapter
+ * @trig: trigger shared by the members
+ * @users: members that still reference the group
+ * @max_msgs: members that can be read by one bus transaction
+ * @lock: serializes the acquisition rounds and the member list
+ * @members: members that are part of the next acquisition round
  */
-struct hsc_range_config {
-	const s32 pmin;
-	const s32 pmax;
+struct hsc_group {
+	struct list_head node;
+	struct device *bus;
+	struct iio_trigger *trig;
+	unsigned int users;
+	unsigned int max_msgs;
+	struct mutex lock;
+	struct list_head members;
 };
 
-/* All min max limits have been converted to pascals */
-static const struct hsc_range_config hsc_range_config[HSC_VARIANTS_MAX] = {
-	[HSC001BA] = { .pmin =       0, .pmax =  100000 },
-	[HSC1_6BA] = { .pmin =       0, .pmax =  160000 },
-	[HSC2_5BA] = { .pmin =       0, .pmax =  250000 },
-	[HSC004BA] = { .pmin =       0, .pmax =  400000 },
-	[HSC006BA] = { .pmin =       0, .pmax =  600000 },
-	[HSC010BA] = { .pmin =       0, .pmax = 1000000 },
-	[HSC1_6MD] = { .pmin =    -160, .pmax =     160 },
-	[HSC2_5MD] = { .pmin =    -250, .pmax =     250 },
-	[HSC004MD] = { .pmin =    -400, .pmax =     400 },
-	[HSC006MD] = { .pmin =    -600, .pmax =     600 },
-	[HSC010MD] = { .pmin =   -1000, .pmax =    1000 },
-	[HSC016MD] = { .pmin =   -1600, .pmax =    1600 },
-	[HSC025MD] = { .pmin =   -2500, .pmax =    2500 },
-	[HSC040MD] = { .pmin =   -4000, .pmax =    4000 },
-	[HSC060MD] = { .pmin =   -6000, .pmax =    6000 },
-	[HSC100MD] = { .pmin =  -10000, .pmax =   10000 },
-	[HSC160MD] = { .pmin =  -16000, .pmax =   16000 },
-	[HSC250MD] = { .pmin =  -25000, .pmax =   25000 },
-	[HSC400MD] = { .pmin =  -40000, .pmax =   40000 },
-	[HSC600MD] = { .pmin =  -60000, .pmax =   60000 },
-	[HSC001BD] = { .pmin = -100000, .pmax =  100000 },
-	[HSC1_6BD] = { .pmin = -160000, .pmax =  160000 },
-	[HSC2_5BD] = { .pmin = -250000, .pmax =  250000 },
-	[HSC004BD] = { .pmin = -400000, .pmax =  400000 },
-	[HSC2_5MG] = { .pmin =       0, .pmax =     250 },
-	[HSC004MG] = { .pmin =       0, .pmax =     400 },
-	[HSC006MG] = { .pmin =       0, .pmax =     600 },
-	[HSC010MG] = { .pmin =       0, .pmax =    1000 },
-	[HSC016MG] = { .pmin =       0, .pmax =    1600 },
-	[HSC025MG] = { .pmin =       0, .pmax =    2500 },
-	[HSC040MG] = { .pmin =       0, .pmax =    4000 },
-	[HSC060MG] = { .pmin =       0, .pmax =    6000 },
-	[HSC100MG] = { .pmin =       0, .pmax =   10000 },
-	[HSC160MG] = { .pmin =       0, .pmax =   16000 },
-	[HSC250MG] = { .pmin =       0, .pmax =   25000 },
-	[HSC400MG] = { .pmin =       0, .pmax =   40000 },
-	[HSC600MG] = { .pmin =       0, .pmax =   60000 },
-	[HSC001BG] = { .pmin =       0, .pmax =  100000 },
-	[HSC1_6BG] = { .pmin =       0, .pmax =  160000 },
-	[HSC2_5BG] = { .pmin =       0, .pmax =  250000 },
-	[HSC004BG] = { .pmin =       0, .pmax =  400000 },
-	[HSC006BG] = { .pmin =       0, .pmax =  600000 },
-	[HSC010BG] = { .pmin =       0, .pmax = 1000000 },
-	[HSC100KA] = { .pmin =       0, .pmax =  100000 },
-	[HSC160KA] = { .pmin =       0, .pmax =  160000 },
-	[HSC250KA] = { .pmin =       0, .pmax =  250000 },
-	[HSC400KA] = { .pmin =       0, .pmax =  400000 },
-	[HSC600KA] = { .pmin =       0, .pmax =  600000 },
-	[HSC001GA] = { .pmin =       0, .pmax = 1000000 },
-	[HSC160LD] = { .pmin =    -160, .pmax =     160 },
-	[HSC250LD] = { .pmin =    -250, .pmax =     250 },
-	[HSC400LD] = { .pmin =    -400, .pmax =     400 },
-	[HSC600LD] = { .pmin =    -600, .pmax =     600 },
-	[HSC001KD] = { .pmin =   -1000, .pmax =    1000 },
-	[HSC1_6KD] = { .pmin =   -1600, .pmax =    1600 },
-	[HSC2_5KD] = { .pmin =   -2500, .pmax =    2500 },
-	[HSC004KD] = { .pmin =   -4000, .pmax =    4000 },
-	[HSC006KD] = { .pmin =   -6000, .pmax =    6000 },
-	[HSC010KD] = { .pmin =  -10000, .pmax =   10000 },
-	[HSC016KD] = { .pmin =  -16000, .pmax =   16000 },
-	[HSC025KD] = { .pmin =  -25000, .pmax =   25000 },
-	[HSC040KD] = { .pmin =  -40000, .pmax =   40000 },
-	[HSC060KD] = { .pmin =  -60000, .pmax =   60000 },
-	[HSC100KD] = { .pmin = -100000, .pmax =  100000 },
-	[HSC160KD] = { .pmin = -160000, .pmax =  160000 },
-	[HSC250KD] = { .pmin = -250000, .pmax =  250000 },
-	[HSC400KD] = { .pmin = -400000, .pmax =  400000 },
-	[HSC250LG] = { .pmin =       0, .pmax =     250 },
-	[HSC400LG] = { .pmin =       0, .pmax =     400 },
-	[HSC600LG] = { .pmin =       0, .pmax =     600 },
-	[HSC001KG] = { .pmin =       0, .pmax =    1000 },
-	[HSC1_6KG] = { .pmin =       0, .pmax =    1600 },
-	[HSC2_5KG] = { .pmin =       0, .pmax =    2500 },
-	[HSC004KG] = { .pmin =       0, .pmax =    4000 },
-	[HSC006KG] = { .pmin =       0, .pmax =    6000 },
-	[HSC010KG] = { .pmin =       0, .pmax =   10000 },
-	[HSC016KG] = { .pmin =       0, .pmax =   16000 },
-	[HSC025KG] = { .pmin =       0, .pmax =   25000 },
-	[HSC040KG] = { .pmin =       0, .pmax =   40000 },
-	[HSC060KG] = { .pmin =       0, .pmax =   60000 },
-	[HSC100KG] = { .pmin =       0, .pmax =  100000 },
-	[HSC160KG] = { .pmin =       0, .pmax =  160000 },
-	[HSC250KG] = { .pmin =       0, .pmax =  250000 },
-	[HSC400KG] = { .pmin =       0, .pmax =  400000 },
-	[HSC600KG] = { .pmin =       0, .pmax =  600000 },
-	[HSC001GG] = { .pmin =       0, .pmax = 1000000 },
-	[HSC015PA] = { .pmin =       0, .pmax =  103421 },
-	[HSC030PA] = { .pmin =       0, .pmax =  206843 },
-	[HSC060PA] = { .pmin =       0, .pmax =  413685 },
-	[HSC100PA] = { .pmin =       0, .pmax =  689476 },
-	[HSC150PA] = { .pmin =       0, .pmax = 1034214 },
-	[HSC0_5ND] = { .pmin =    -125, .pmax =     125 },
-	[HSC001ND] = { .pmin =    -249, .pmax =     249 },
-	[HSC002ND] = { .pmin =    -498, .pmax =     498 },
-	[HSC004ND] = { .pmin =    -996, .pmax =     996 },
-	[HSC005ND] = { .pmin =   -1245, .pmax =    1245 },
-	[HSC010ND] = { .pmin =   -2491, .pmax =    2491 },
-	[HSC020ND] = { .pmin =   -4982, .pmax =    4982 },
-	[HSC030ND] = { .pmin =   -7473, .pmax =    7473 },
-	[HSC001PD] = { .pmin =   -6895, .pmax =    6895 },
-	[HSC005PD] = { .pmin =  -34474, .pmax =   34474 },
-	[HSC015PD] = { .pmin = -103421, .pmax =  103421 },
-	[HSC030PD] = { .pmin = -206843, .pmax =  206843 },
-	[HSC060PD] = { .pmin = -413685, .pmax =  413685 },
-	[HSC001NG] = { .pmin =       0, .pmax =     249 },
-	[HSC002NG] = { .pmin =       0, .pmax =     498 },
-	[HSC004NG] = { .pmin =       0, .pmax =     996 },
-	[HSC005NG] = { .pmin =       0, .pmax =    1245 },
-	[HSC010NG] = { .pmin =       0, .pmax =    2491 },
-	[HSC020NG] = { .pmin =       0, .pmax =    4982 },
-	[HSC030NG] = { .pmin =       0, .pmax =    7473 },
-	[HSC001PG] = { .pmin =       0, .pmax =    6895 },
-	[HSC005PG] = { .pmin =       0, .pmax =   34474 },
-	[HSC015PG] = { .pmin =       0, .pmax =  103421 },
-	[HSC030PG] = { .pmin =       0, .pmax =  206843 },
-	[HSC060PG] = { .pmin =       0, .pmax =  413685 },
-	[HSC100PG] = { .pmin =       0, .pmax =  689476 },
-	[HSC150PG] = { .pmin =       0, .pmax = 1034214 },
-};
+static LIST_HEAD(hsc_groups);
+static DEFINE_MUTEX(hsc_groups_lock);
 
 /**
  * hsc_measurement_is_valid() - validate last conversion via status bits
@@ -284,12 +97,28 @@ static bool hsc_measurement_is_valid(struct hsc_data *data)
 	return !(data->buffer[0] & HSC_STATUS_MASK);
 }
 
-static int hsc_get_measurement(struct hsc_data *data)
+/*
+ * until the startup time has passed since vdd got enabled the sensor answers
+ * with stale or invalid data, so the first reads are delayed instead of being
+ * failed with -EAGAIN
+ */
+static void hsc_wait_ready(struct hsc_data *data)
+{
+	s64 remaining = ktime_us_delta(data->ready_time, ktime_get());
+
+	if (remaining > 0)
+		fsleep(remaining);
+}
+
+static int hsc_get_measurement(struct hsc_data *data, u8 len)
 {
 	const struct hsc_chip_data *chip = data->chip;
 	int ret;
 
-	ret = data->recv_cb(data);
+	hsc_wait_ready(data);
+
+	data->read_len = len;
+	ret = data->ops->recv(data);
 	if (ret < 0)
 		return ret;
 
@@ -300,29 +129,528 @@ static int hsc_get_measurement(struct hsc_data *data)
 	return 0;
 }
 
+/*
+ * a trigger that fires faster than the sensor updates its output finds a
+ * stale conversion. instead of losing the sample the output is read again,
+ * without the response time delay, until a new conversion shows up or the
+ * retry budget is spent. other error conditions are not retried.
+ */
+static int hsc_get_fresh_measurement(struct hsc_data *data, u8 len)
+{
+	ktime_t deadline;
+	unsigned int retries = 0;
+	int ret;
+
+	ret = hsc_get_measurement(data, len);
+	if (ret != -EAGAIN || !data->retry_max)
+		goto out;
+
+	deadline = ktime_add_us(ktime_get(), data->retry_us);
+	data->polling = true;
+	while (ret == -EAGAIN && retries < data->retry_max &&
+	       FIELD_GET(HSC_STATUS_MASK, data->buffer[0]) == HSC_STATUS_STALE &&
+	       ktime_before(ktime_get(), deadline)) {
+		usleep_range(HSC_UPDATE_PERIOD_US / 4, HSC_UPDATE_PERIOD_US / 2);
+		ret = hsc_get_measurement(data, len);
+		retries++;
+	}
+	data->polling = false;
+
+	data->retry_stats.reads += retries;
+	if (!ret && retries)
+		data->retry_stats.recovered++;
+out:
+	if (ret == -EAGAIN)
+		data->retry_stats.dropped++;
+
+	return ret;
+}
+
+/*
+ * in_pressure_raw and in_temp_raw are usually read back to back by monitoring
+ * scripts while a single transfer provides both values. a channel that has
+ * not been reported yet is served from the last conversion as long as that
+ * is younger than the coherency window, otherwise a new transfer is done.
+ */
+static int hsc_get_coherent_measurement(struct hsc_data *data,
+					unsigned int chan, u32 *recvd)
+{
+	int ret;
+
+	guard(mutex)(&data->lock);
+
+	if (data->coherency_us && test_bit(chan, &data->unread) &&
+	    ktime_us_delta(ktime_get(), data->conv_time) < data->coherency_us) {
+		__clear_bit(chan, &data->unread);
+		*recvd = get_unaligned_be32(data->buffer);
+		return 0;
+	}
+
+	ret = hsc_get_measurement(data, data->full_len);
+	if (ret) {
+		data->unread = 0;
+		return ret;
+	}
+
+	data->conv_time = ktime_get();
+	data->unread = HSC_DATA_CHANNELS & ~BIT(chan);
+	*recvd = get_unaligned_be32(data->buffer);
+
+	return 0;
+}
+
+/*
+ * while the buffer is enabled sysfs reads are served from the latest sample
+ * acquired by the trigger handler. no transfer is done, so the stream keeps
+ * the bus to itself and the reader never waits for the conversion mutex.
+ */
+static int hsc_get_snapshot(struct hsc_data *data, unsigned int chan,
+			    u32 *recvd)
+{
+	unsigned long chans;
+	unsigned int seq;
+
+	do {
+		seq = read_seqbegin(&data->snap_lock);
+		*recvd = data->snap.recvd;
+		chans = data->snap.chans;
+	} while (read_seqretry(&data->snap_lock, seq));
+
+	if (!chans)
+		return -EAGAIN;
+
+	/* temperature is not read if it is not part of the scan */
+	if (!test_bit(chan, &chans))
+		return -EBUSY;
+
+	return 0;
+}
+
+/*
+ * pack the enabled channels of a buffered transfer and publish the sample.
+ * may be called from the completion of an asynchronous transfer.
+ */
+static void hsc_store_scan(struct hsc_data *data, const u8 *rx)
+{
+	struct iio_dev *indio_dev = data->indio_dev;
+	unsigned int bit, i = 0;
+	unsigned long flags;
+
+	/* channel N is found at offset 2 * N within the transfer */
+	for_each_set_bit(bit, indio_dev->active_scan_mask,
+			 indio_dev->masklength)
+		memcpy(&data->scan.chan[i++], &rx[bit * 2], 2);
+
+	write_seqlock_irqsave(&data->snap_lock, flags);
+	data->snap.recvd = get_unaligned_be32(rx);
+	data->snap.chans = data->scan_len == data->full_len ?
+			   HSC_DATA_CHANNELS : BIT(0);
+	write_sequnlock_irqrestore(&data->snap_lock, flags);
+}
+
+void hsc_async_complete(struct hsc_data *data, const u8 *rx, int status,
+			s64 timestamp)
+{
+	if (!status && !(rx[0] & HSC_STATUS_MASK)) {
+		hsc_store_scan(data, rx);
+		iio_push_to_buffers_with_timestamp(data->indio_dev,
+						   &data->scan, timestamp);
+	}
+
+	if (atomic_dec_and_test(&data->async_inflight))
+		wake_up_var(&data->async_inflight);
+}
+EXPORT_SYMBOL_NS(hsc_async_complete, IIO_HONEYWELL_HSC030PA);
+
+/*
+ * the read is queued and the trigger is released right away, so the next
+ * trigger can queue another read while this one is still on the bus or
+ * being pushed. if the bus driver has no room for another read the sample
+ * is dropped.
+ */
+static void hsc_capture_async(struct hsc_data *data)
+{
+	int ret;
+
+	hsc_wait_ready(data);
+	data->read_len = data->scan_len;
+
+	atomic_inc(&data->async_inflight);
+	ret = data->ops->recv_async(data);
+	if (ret && atomic_dec_and_test(&data->async_inflight))
+		wake_up_var(&data->async_inflight);
+}
+
+/*
+ * the first member of a group reads all the members with as few bus
+ * transactions as the bus allows and pushes every result into the buffer of
+ * its owner. the trigger handlers of the other members have nothing left to
+ * do. a combined transaction that gets refused is retried one member at a
+ * time.
+ */
+static void hsc_group_capture(struct hsc_data *data)
+{
+	struct hsc_data *members[HSC_GROUP_MAX];
+	bool read[HSC_GROUP_MAX];
+	struct hsc_group *group = data->group;
+	struct hsc_data *member;
+	unsigned int i, j, n, num = 0;
+	bool valid;
+	int ret;
+
+	guard(mutex)(&group->lock);
+
+	if (list_first_entry_or_null(&group->members, struct hsc_data,
+				     group_node) != data)
+		return;
+
+	/*
+	 * the buffers of the members are only accessed by this round, sysfs
+	 * reads are served from the snapshot while the members are buffering
+	 */
+	list_for_each_entry(member, &group->members, group_node) {
+		hsc_wait_ready(member);
+		member->read_len = member->scan_len;
+		members[num++] = member;
+	}
+
+	if (!num)
+		return;
+
+	msleep_interruptible(HSC_RESP_TIME_MS);
+
+	for (i = 0; i < num; i += n) {
+		n = min(num - i, group->max_msgs);
+		ret = data->ops->group_recv(&members[i], n);
+		for (j = i; j < i + n; j++) {
+			if (ret && n > 1)
+				read[j] = !data->ops->group_recv(&members[j], 1);
+			else
+				read[j] = !ret;
+		}
+	}
+
+	for (i = 0; i < num; i++) {
+		member = members[i];
+		if (!read[i])
+			continue;
+
+		mutex_lock(&member->lock);
+		member->is_valid = member->chip->valid(member);
+		valid = member->is_valid;
+		if (valid)
+			hsc_store_scan(member, member->buffer);
+		mutex_unlock(&member->lock);
+
+		if (valid)
+			iio_push_to_buffers_with_timestamp(member->indio_dev,
+					&member->scan,
+					iio_get_time_ns(member->indio_dev));
+	}
+}
+
+static int hsc_group_join(struct hsc_data *data)
+{
+	struct iio_trigger *trig = data->indio_dev->trig;
+	struct device *bus = data->dev->parent;
+	struct hsc_group *group;
+
+	guard(mutex)(&hsc_groups_lock);
+
+	list_for_each_entry(group, &hsc_groups, node)
+		if (group->bus == bus && group->trig == trig)
+			goto found;
+
+	group = kzalloc(sizeof(*group), GFP_KERNEL);
+	if (!group)
+		return -ENOMEM;
+
+	group->bus = bus;
+	group->trig = trig;
+	group->max_msgs = HSC_GROUP_MAX;
+	if (data->ops->group_max)
+		group->max_msgs = max(data->ops->group_max(data), 1U);
+	mutex_init(&group->lock);
+	INIT_LIST_HEAD(&group->members);
+	list_add(&group->node, &hsc_groups);
+
+found:
+	if (group->users == HSC_GROUP_MAX)
+		return -EBUSY;
+
+	group->users++;
+	data->group = group;
+
+	mutex_lock(&group->lock);
+	list_add_tail(&data->group_node, &group->members);
+	mutex_unlock(&group->lock);
+
+	return 0;
+}
+
+/* called before the trigger is detached, no more pushes into our buffer */
+static void hsc_group_leave(struct hsc_data *data)
+{
+	struct hsc_group *group = data->group;
+
+	mutex_lock(&group->lock);
+	list_del_init(&data->group_node);
+	mutex_unlock(&group->lock);
+}
+
+/* called once our own trigger handler can no longer run */
+static void hsc_group_put(struct hsc_data *data)
+{
+	struct hsc_group *group = data->group;
+
+	guard(mutex)(&hsc_groups_lock);
+
+	data->group = NULL;
+	if (--group->users)
+		return;
+
+	list_del(&group->node);
+	mutex_destroy(&group->lock);
+	kfree(group);
+}
+
+static void hsc_capture(struct iio_dev *indio_dev)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
+	int ret;
+
+	if (data->group) {
+		hsc_group_capture(data);
+		goto out;
+	}
+
+	if (data->pipelined) {
+		hsc_capture_async(data);
+		goto out;
+	}
+
+	mutex_lock(&data->lock);
+	ret = hsc_get_fresh_measurement(data, data->scan_len);
+	if (!ret)
+		hsc_store_scan(data, data->buffer);
+	mutex_unlock(&data->lock);
+
+	if (!ret)
+		iio_push_to_buffers_with_timestamp(indio_dev, &data->scan,
+						   iio_get_time_ns(indio_dev));
+
+out:
+	iio_trigger_notify_done(indio_dev->trig);
+}
+
+static void hsc_rt_work(struct kthread_work *work)
+{
+	struct hsc_data *data = container_of(work, struct hsc_data, rt.work);
+
+	hsc_capture(data->indio_dev);
+}
+
+/*
+ * in real-time capture mode the acquisition is handed over to a dedicated
+ * SCHED_FIFO thread directly from the trigger's hard irq context, so the
+ * sample interval does not depend on the scheduling of the generic pollfunc
+ * irq thread.
+ */
+static irqreturn_t hsc_trigger_top_half(int irq, void *private)
+{
+	struct iio_poll_func *pf = private;
+	struct hsc_data *data = iio_priv(pf->indio_dev);
+
+	if (!iio_rt_capture_queue(&data->rt))
+		return IRQ_WAKE_THREAD;
+
+	return IRQ_HANDLED;
+}
+
 static irqreturn_t hsc_trigger_handler(int irq, void *private)
 {
 	struct iio_poll_func *pf = private;
 	struct iio_dev *indio_dev = pf->indio_dev;
 	struct hsc_data *data = iio_priv(indio_dev);
+
+	/* nested triggers never call the top half */
+	if (iio_rt_capture_queue(&data->rt))
+		return IRQ_HANDLED;
+
+	hsc_capture(indio_dev);
+
+	return IRQ_HANDLED;
+}
+
+/*
+ * free-running mode is used when the buffer is enabled without a trigger.
+ * the sensor updates its output register every HSC_UPDATE_PERIOD_US and flags
+ * every further read of the same conversion as stale, so the output is polled
+ * a few times per update period and only new conversions get pushed. the
+ * timestamp is taken right before the read that first returned the
+ * conversion. the response time delay of the bus drivers is skipped since the
+ * stale flag already tells if the conversion is new.
+ */
+static int hsc_freerun_thread(void *arg)
+{
+	struct iio_dev *indio_dev = arg;
+	struct hsc_data *data = iio_priv(indio_dev);
+	bool fresh;
+	s64 timestamp;
+	int ret;
+
+	hsc_wait_ready(data);
+
+	while (!kthread_should_stop()) {
+		mutex_lock(&data->lock);
+		timestamp = iio_get_time_ns(indio_dev);
+		data->read_len = data->scan_len;
+		ret = data->ops->recv(data);
+		fresh = ret >= 0 &&
+			FIELD_GET(HSC_STATUS_MASK, data->buffer[0]) ==
+				HSC_STATUS_VALID;
+		if (fresh)
+			hsc_store_scan(data, data->buffer);
+		mutex_unlock(&data->lock);
+
+		if (fresh)
+			iio_push_to_buffers_with_timestamp(indio_dev, &data->scan,
+							   timestamp);
+
+		usleep_range(HSC_UPDATE_PERIOD_US / 4, HSC_UPDATE_PERIOD_US / 2);
+	}
+
+	return 0;
+}
+
+static int hsc_buffer_preenable(struct iio_dev *indio_dev)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
 	int ret;
 
-	ret = hsc_get_measurement(data);
+	mutex_lock(&data->lock);
+	/* the buffer no longer holds what the sysfs reader has seen */
+	data->unread = 0;
+	write_seqlock_irq(&data->snap_lock);
+	data->snap.chans = 0;
+	write_sequnlock_irq(&data->snap_lock);
+	mutex_unlock(&data->lock);
+
+	/* the sensor stays powered while the buffer is enabled */
+	ret = pm_runtime_resume_and_get(data->dev);
 	if (ret)
-		goto error;
+		return ret;
 
-	memcpy(&data->scan.chan[0], &data->buffer[0], 2);
-	memcpy(&data->scan.chan[1], &data->buffer[2], 2);
+	/* without a trigger the freerun thread gets the real-time settings */
+	if (iio_device_get_current_mode(indio_dev) == INDIO_BUFFER_SOFTWARE)
+		return 0;
 
-	iio_push_to_buffers_with_timestamp(indio_dev, &data->scan,
-					   iio_get_time_ns(indio_dev));
+	ret = iio_rt_capture_start(&data->rt, data->dev);
+	if (ret)
+		pm_runtime_put_autosuspend(data->dev);
 
-error:
-	iio_trigger_notify_done(indio_dev->trig);
+	return ret;
+}
 
-	return IRQ_HANDLED;
+static int hsc_buffer_postenable(struct iio_dev *indio_dev)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
+	struct task_struct *task;
+	int ret;
+
+	if (iio_device_get_current_mode(indio_dev) == INDIO_BUFFER_SOFTWARE) {
+		task = kthread_create(hsc_freerun_thread, indio_dev,
+				      "%s-freerun", dev_name(data->dev));
+		if (IS_ERR(task))
+			return PTR_ERR(task);
+
+		if (data->rt.prio) {
+			ret = iio_rt_capture_set_sched(&data->rt, task);
+			if (ret) {
+				kthread_stop(task);
+				return ret;
+			}
+		}
+
+		/* set before the thread does its first read */
+		data->polling = true;
+		data->freerun = task;
+		wake_up_process(task);
+		return 0;
+	}
+
+	if (!data->group_capture)
+		return 0;
+
+	return hsc_group_join(data);
+}
+
+static int hsc_buffer_predisable(struct iio_dev *indio_dev)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
+
+	if (data->freerun) {
+		kthread_stop(data->freerun);
+		data->freerun = NULL;
+		data->polling = false;
+	}
+
+	if (data->group)
+		hsc_group_leave(data);
+
+	return 0;
+}
+
+static void hsc_async_flush(struct hsc_data *data)
+{
+	wait_var_event(&data->async_inflight,
+		       !atomic_read(&data->async_inflight));
+}
+
+static int hsc_buffer_postdisable(struct iio_dev *indio_dev)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
+
+	if (data->group)
+		hsc_group_put(data);
+
+	/* the trigger is detached, no more reads get queued */
+	hsc_async_flush(data);
+
+	iio_rt_capture_stop(&data->rt);
+
+	pm_runtime_mark_last_busy(data->dev);
+	pm_runtime_put_autosuspend(data->dev);
+
+	return 0;
 }
 
+/*
+ * the pressure is provided by the first two bytes of a transfer, the
+ * temperature is only clocked out if the transfer is extended to four bytes.
+ * buffered captures that only need the pressure get by with half the bus time.
+ */
+static int hsc_update_scan_mode(struct iio_dev *indio_dev,
+				const unsigned long *scan_mask)
+{
+	struct hsc_data *data = iio_priv(indio_dev);
+
+	/* temperature is scan index 1 */
+	if (test_bit(1, scan_mask))
+		data->scan_len = data->full_len;
+	else
+		data->scan_len = HSC_REG_PRESSURE_RD_SIZE;
+
+	return 0;
+}
+
+static const struct iio_buffer_setup_ops hsc_buffer_setup_ops = {
+	.preenable = hsc_buffer_preenable,
+	.postenable = hsc_buffer_postenable,
+	.predisable = hsc_buffer_predisable,
+	.postdisable = hsc_buffer_postdisable,
+};
+
 /*
  * IIO ABI expects
  * value = (conv + offset) * scale
@@ -336,6 +664,10 @@ error:
  *  scale = a * 1000 = .097703957 * 1000 = 97.703957
  *  offset = b/a = -50 / .097703957 = -50000000 / 97704
  *
+ *  with an 8 bit temperature conv8 = conv >> 3, so a8 = 8 * a
+ *  scale = 781.631656
+ *  offset = -50 / (8 * 200 / 2047) = -2047 / 32
+ *
  *  based on the datasheet
  *  pressure = (conv - Omin) * Q + Pmin =
  *          ((conv - Omin) + Pmin/Q) * Q
@@ -353,17 +685,33 @@ static int hsc_read_raw(struct iio_dev *indio_dev,
 
 	switch (mask) {
 	case IIO_CHAN_INFO_RAW:
-		ret = hsc_get_measurement(data);
+		ret = iio_device_claim_direct_mode(indio_dev);
+		if (ret) {
+			ret = hsc_get_snapshot(data, channel->scan_index,
+					       &recvd);
+		} else {
+			ret = pm_runtime_resume_and_get(data->dev);
+			if (!ret) {
+				ret = hsc_get_coherent_measurement(data,
+							channel->scan_index,
+							&recvd);
+				pm_runtime_mark_last_busy(data->dev);
+				pm_runtime_put_autosuspend(data->dev);
+			}
+			iio_device_release_direct_mode(indio_dev);
+		}
 		if (ret)
 			return ret;
 
-		recvd = get_unaligned_be32(data->buffer);
 		switch (channel->type) {
 		case IIO_PRESSURE:
 			*val = FIELD_GET(HSC_PRESSURE_MASK, recvd);
 			return IIO_VAL_INT;
 		case IIO_TEMP:
-			*val = FIELD_GET(HSC_TEMPERATURE_MASK, recvd);
+			if (data->temp_bits == 8)
+				*val = FIELD_GET(HSC_TEMPERATURE8_MASK, recvd);
+			else
+				*val = FIELD_GET(HSC_TEMPERATURE_MASK, recvd);
 			return IIO_VAL_INT;
 		default:
 			return -EINVAL;
@@ -372,8 +720,13 @@ static int hsc_read_raw(struct iio_dev *indio_dev,
 	case IIO_CHAN_INFO_SCALE:
 		switch (channel->type) {
 		case IIO_TEMP:
-			*val = 97;
-			*val2 = 703957;
+			if (data->temp_bits == 8) {
+				*val = 781;
+				*val2 = 631656;
+			} else {
+				*val = 97;
+				*val2 = 703957;
+			}
 			return IIO_VAL_INT_PLUS_MICRO;
 		case IIO_PRESSURE:
 			*val = data->p_scale;
@@ -386,8 +739,13 @@ static int hsc_read_raw(struct iio_dev *indio_dev,
 	case IIO_CHAN_INFO_OFFSET:
 		switch (channel->type) {
 		case IIO_TEMP:
-			*val = -50000000;
-			*val2 = 97704;
+			if (data->temp_bits == 8) {
+				*val = -2047;
+				*val2 = 32;
+			} else {
+				*val = -50000000;
+				*val2 = 97704;
+			}
 			return IIO_VAL_FRACTIONAL;
 		case IIO_PRESSURE:
 			*val = data->p_offset;
@@ -402,7 +760,7 @@ static int hsc_read_raw(struct iio_dev *indio_dev,
 	}
 }
 
-static const struct iio_chan_spec hsc_channels[] = {
+const struct iio_chan_spec hsc_channels[HSC_NUM_CHANNELS] = {
 	{
 		.type = IIO_PRESSURE,
 		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
@@ -432,9 +790,346 @@ static const struct iio_chan_spec hsc_channels[] = {
 	},
 	IIO_CHAN_SOFT_TIMESTAMP(2),
 };
+EXPORT_SYMBOL_NS(hsc_channels, IIO_HONEYWELL_HSC030PA);
+
+/* only the most significant temperature byte is transferred */
+const struct iio_chan_spec hsc_channels_t8[HSC_NUM_CHANNELS] = {
+	{
+		.type = IIO_PRESSURE,
+		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
+				      BIT(IIO_CHAN_INFO_SCALE) |
+				      BIT(IIO_CHAN_INFO_OFFSET),
+		.scan_index = 0,
+		.scan_type = {
+			.sign = 'u',
+			.realbits = 14,
+			.storagebits = 16,
+			.endianness = IIO_BE,
+		},
+	},
+	{
+		.type = IIO_TEMP,
+		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
+				      BIT(IIO_CHAN_INFO_SCALE) |
+				      BIT(IIO_CHAN_INFO_OFFSET),
+		.scan_index = 1,
+		.scan_type = {
+			.sign = 'u',
+			.realbits = 8,
+			.storagebits = 16,
+			.shift = 8,
+			.endianness = IIO_BE,
+		},
+	},
+	IIO_CHAN_SOFT_TIMESTAMP(2),
+};
+EXPORT_SYMBOL_NS(hsc_channels_t8, IIO_HONEYWELL_HSC030PA);
+
+static ssize_t coherency_window_us_show(struct device *dev,
+					struct device_attribute *attr,
+					char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->coherency_us);
+}
+
+static ssize_t coherency_window_us_store(struct device *dev,
+					 struct device_attribute *attr,
+					 const char *buf, size_t len)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 window;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &window);
+	if (ret)
+		return ret;
+
+	if (window > USEC_PER_SEC)
+		return -EINVAL;
+
+	guard(mutex)(&data->lock);
+	data->coherency_us = window;
+
+	return len;
+}
+
+static ssize_t stale_retry_count_show(struct device *dev,
+				      struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->retry_max);
+}
+
+static ssize_t stale_retry_count_store(struct device *dev,
+				       struct device_attribute *attr,
+				       const char *buf, size_t len)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 count;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &count);
+	if (ret)
+		return ret;
+
+	guard(mutex)(&data->lock);
+	data->retry_max = count;
+
+	return len;
+}
+
+static ssize_t stale_retry_us_show(struct device *dev,
+				   struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->retry_us);
+}
+
+static ssize_t stale_retry_us_store(struct device *dev,
+				    struct device_attribute *attr,
+				    const char *buf, size_t len)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 budget;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &budget);
+	if (ret)
+		return ret;
+
+	if (budget > USEC_PER_SEC)
+		return -EINVAL;
+
+	guard(mutex)(&data->lock);
+	data->retry_us = budget;
+
+	return len;
+}
+
+static ssize_t stale_retries_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	guard(mutex)(&data->lock);
+	return sysfs_emit(buf, "%lu\n", data->retry_stats.reads);
+}
+
+static ssize_t stale_recovered_show(struct device *dev,
+				    struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	guard(mutex)(&data->lock);
+	return sysfs_emit(buf, "%lu\n", data->retry_stats.recovered);
+}
+
+static ssize_t stale_dropped_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	guard(mutex)(&data->lock);
+	return sysfs_emit(buf, "%lu\n", data->retry_stats.dropped);
+}
+
+static ssize_t group_capture_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%d\n", data->group_capture);
+}
+
+static ssize_t group_capture_store(struct device *dev,
+				   struct device_attribute *attr,
+				   const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct hsc_data *data = iio_priv(indio_dev);
+	bool enable;
+	int ret;
+
+	ret = kstrtobool(buf, &enable);
+	if (ret)
+		return ret;
+
+	if (enable && !data->ops->group_recv)
+		return -EOPNOTSUPP;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	data->group_capture = enable;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+
+static ssize_t pipelined_capture_show(struct device *dev,
+				      struct device_attribute *attr, char *buf)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%d\n", data->pipelined);
+}
+
+static ssize_t pipelined_capture_store(struct device *dev,
+				       struct device_attribute *attr,
+				       const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct hsc_data *data = iio_priv(indio_dev);
+	bool enable;
+	int ret;
+
+	ret = kstrtobool(buf, &enable);
+	if (ret)
+		return ret;
+
+	if (enable && !data->ops->recv_async)
+		return -EOPNOTSUPP;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	data->pipelined = enable;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+
+/*
+ * a burst returns consecutive pressure conversions out of a single sysfs
+ * read. the output is polled without the response time delay and only the
+ * conversions that are not flagged stale are taken, so the samples follow
+ * each other at the update period of the sensor. every line holds the
+ * timestamp taken right before the transfer and the raw pressure.
+ */
+static int hsc_get_burst(struct hsc_data *data, char *buf)
+{
+	unsigned int count = 0;
+	ktime_t deadline;
+	s64 timestamp;
+	u32 recvd;
+	int len = 0;
+	int ret;
+
+	guard(mutex)(&data->lock);
+
+	/* the conversion the coherency window refers to gets overwritten */
+	data->unread = 0;
+	data->polling = true;
+	deadline = ktime_add_us(ktime_get(), HSC_BURST_TIMEOUT_US);
+	for (;;) {
+		timestamp = iio_get_time_ns(data->indio_dev);
+		ret = hsc_get_measurement(data, HSC_REG_PRESSURE_RD_SIZE);
+		if (!ret) {
+			recvd = get_unaligned_be32(data->buffer);
+			len += sysfs_emit_at(buf, len, "%lld %lu\n", timestamp,
+					     FIELD_GET(HSC_PRESSURE_MASK, recvd));
+			deadline = ktime_add_us(ktime_get(),
+						HSC_BURST_TIMEOUT_US);
+			if (++count == data->burst_len)
+				break;
+		} else if (ret != -EAGAIN ||
+			   FIELD_GET(HSC_STATUS_MASK, data->buffer[0]) !=
+				HSC_STATUS_STALE) {
+			break;
+		} else if (ktime_after(ktime_get(), deadline)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+		usleep_range(HSC_UPDATE_PERIOD_US / 4, HSC_UPDATE_PERIOD_US / 2);
+	}
+	data->polling = false;
+
+	return ret ?: len;
+}
+
+static ssize_t in_pressure_raw_burst_show(struct device *dev,
+					  struct device_attribute *attr,
+					  char *buf)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct hsc_data *data = iio_priv(indio_dev);
+	int ret;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	ret = pm_runtime_resume_and_get(data->dev);
+	if (!ret) {
+		ret = hsc_get_burst(data, buf);
+		pm_runtime_mark_last_busy(data->dev);
+		pm_runtime_put_autosuspend(data->dev);
+	}
+	iio_device_release_direct_mode(indio_dev);
+
+	return ret;
+}
+
+static ssize_t in_pressure_raw_burst_store(struct device *dev,
+					   struct device_attribute *attr,
+					   const char *buf, size_t len)
+{
+	struct hsc_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 count;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &count);
+	if (ret)
+		return ret;
+
+	if (!count || count > HSC_BURST_MAX)
+		return -EINVAL;
+
+	guard(mutex)(&data->lock);
+	data->burst_len = count;
+
+	return len;
+}
+
+IIO_RT_CAPTURE_DEVICE_ATTRS(struct hsc_data, rt);
+static IIO_DEVICE_ATTR_RW(coherency_window_us, 0);
+static IIO_DEVICE_ATTR_RW(group_capture, 0);
+static IIO_DEVICE_ATTR_RW(in_pressure_raw_burst, 0);
+static IIO_DEVICE_ATTR_RW(pipelined_capture, 0);
+static IIO_DEVICE_ATTR_RW(stale_retry_count, 0);
+static IIO_DEVICE_ATTR_RW(stale_retry_us, 0);
+static IIO_DEVICE_ATTR_RO(stale_retries, 0);
+static IIO_DEVICE_ATTR_RO(stale_recovered, 0);
+static IIO_DEVICE_ATTR_RO(stale_dropped, 0);
+
+static struct attribute *hsc_attrs[] = {
+	IIO_RT_CAPTURE_ATTRS,
+	&iio_dev_attr_coherency_window_us.dev_attr.attr,
+	&iio_dev_attr_group_capture.dev_attr.attr,
+	&iio_dev_attr_in_pressure_raw_burst.dev_attr.attr,
+	&iio_dev_attr_pipelined_capture.dev_attr.attr,
+	&iio_dev_attr_stale_retry_count.dev_attr.attr,
+	&iio_dev_attr_stale_retry_us.dev_attr.attr,
+	&iio_dev_attr_stale_retries.dev_attr.attr,
+	&iio_dev_attr_stale_recovered.dev_attr.attr,
+	&iio_dev_attr_stale_dropped.dev_attr.attr,
+	NULL
+};
+
+static const struct attribute_group hsc_attr_group = {
+	.attrs = hsc_attrs,
+};
 
 static const struct iio_info hsc_info = {
 	.read_raw = hsc_read_raw,
+	.update_scan_mode = hsc_update_scan_mode,
+	.attrs = &hsc_attr_group,
 };
 
 static const struct hsc_chip_data hsc_chip = {
@@ -443,12 +1138,84 @@ static const struct hsc_chip_data hsc_chip = {
 	.num_channels = ARRAY_SIZE(hsc_channels),
 };
 
-int hsc_common_probe(struct device *dev, hsc_recv_fn recv)
+static const struct hsc_chip_data hsc_chip_t8 = {
+	.valid = hsc_measurement_is_valid,
+	.channels = hsc_channels_t8,
+	.num_channels = ARRAY_SIZE(hsc_channels_t8),
+};
+
+/*
+ * runtime suspend switches off vdd. after resume the sensor needs its startup
+ * time again before it provides valid conversions, reads wait for it via
+ * ready_time. power/autosuspend_delay_ms sets how long the sensor stays on
+ * after the last read, trading idle power for the startup latency.
+ */
+static int hsc_runtime_suspend(struct device *dev)
+{
+	struct hsc_data *data = iio_priv(dev_get_drvdata(dev));
+
+	return regulator_disable(data->vdd);
+}
+
+static int hsc_runtime_resume(struct device *dev)
 {
+	struct hsc_data *data = iio_priv(dev_get_drvdata(dev));
+	int ret;
+
+	ret = regulator_enable(data->vdd);
+	if (ret)
+		return ret;
+
+	data->ready_time = ktime_add_us(ktime_get(), HSC_STARTUP_TIME_US);
+
+	return 0;
+}
+
+EXPORT_NS_RUNTIME_DEV_PM_OPS(hsc_pm_ops, hsc_runtime_suspend,
+			     hsc_runtime_resume, NULL, IIO_HONEYWELL_HSC030PA);
+
+/*
+ * the scale and offset of the pressure ranges listed in the datasheets are
+ * precomputed in hsc_conv[], only a custom range needs the math at probe time.
+ * scripts/parse_variants_table.sh does the same integer operations.
+ */
+static void hsc_calc_conv(struct hsc_data *hsc)
+{
+	s64 tmp;
+
+	tmp = div_s64(((s64)(hsc->pmax - hsc->pmin)) * MICRO,
+		      hsc->outmax - hsc->outmin);
+	hsc->p_scale = div_s64_rem(tmp, NANO, &hsc->p_scale_dec);
+	tmp = div_s64(((s64)hsc->pmin * (s64)(hsc->outmax - hsc->outmin)) * MICRO,
+		      hsc->pmax - hsc->pmin);
+	tmp -= (s64)hsc->outmin * MICRO;
+	hsc->p_offset = div_s64_rem(tmp, MICRO, &hsc->p_offset_dec);
+}
+
+static void hsc_vdd_disable(void *arg)
+{
+	regulator_disable(arg);
+}
+
+/* resume first so vdd is enabled when hsc_vdd_disable() runs */
+static void hsc_pm_disable(void *arg)
+{
+	struct device *dev = arg;
+
+	pm_runtime_get_sync(dev);
+	pm_runtime_put_noidle(dev);
+	pm_runtime_disable(dev);
+	pm_runtime_dont_use_autosuspend(dev);
+}
+
+int hsc_common_probe(struct device *dev, const struct hsc_bus_ops *ops,
+		     void *bus_priv)
+{
+	const struct hsc_conv *conv;
 	struct hsc_data *hsc;
 	struct iio_dev *indio_dev;
 	const char *triplet;
-	s64 tmp;
+	int variant = -1;
 	int ret;
 
 	indio_dev = devm_iio_device_alloc(dev, sizeof(*hsc));
@@ -458,8 +1225,20 @@ int hsc_common_probe(struct device *dev, hsc_recv_fn recv)
 	hsc = iio_priv(indio_dev);
 
 	hsc->chip = &hsc_chip;
-	hsc->recv_cb = recv;
+	hsc->ops = ops;
+	hsc->bus_priv = bus_priv;
 	hsc->dev = dev;
+	hsc->indio_dev = indio_dev;
+	hsc->coherency_us = HSC_COHERENCY_WINDOW_US;
+	hsc->retry_max = HSC_RETRY_MAX;
+	hsc->retry_us = HSC_RETRY_US;
+	hsc->burst_len = 1;
+	hsc->temp_bits = 11;
+	mutex_init(&hsc->lock);
+	seqlock_init(&hsc->snap_lock);
+	atomic_set(&hsc->async_inflight, 0);
+	INIT_LIST_HEAD(&hsc->group_node);
+	iio_rt_capture_init(&hsc->rt, hsc_rt_work);
 
 	ret = device_property_read_u32(dev, "honeywell,transfer-function",
 				       &hsc->function);
@@ -498,37 +1277,81 @@ int hsc_common_probe(struct device *dev, hsc_recv_fn recv)
 			return dev_err_probe(dev, -EINVAL,
 				    "honeywell,pressure-triplet is invalid\n");
 
-		hsc->pmin = hsc_range_config[ret].pmin;
-		hsc->pmax = hsc_range_config[ret].pmax;
+		variant = ret;
+		hsc->pmin = hsc_range_config[variant].pmin;
+		hsc->pmax = hsc_range_config[variant].pmax;
 	}
 
 	if (hsc->pmin >= hsc->pmax)
 		return dev_err_probe(dev, -EINVAL,
 				     "pressure limits are invalid\n");
 
-	ret = devm_regulator_get_enable(dev, "vdd");
+	device_property_read_u32(dev, "honeywell,temperature-bits",
+				 &hsc->temp_bits);
+	switch (hsc->temp_bits) {
+	case 8:
+		hsc->chip = &hsc_chip_t8;
+		hsc->full_len = HSC_REG_TEMP8_RD_SIZE;
+		break;
+	case 11:
+		hsc->full_len = HSC_REG_MEASUREMENT_RD_SIZE;
+		break;
+	default:
+		return dev_err_probe(dev, -EINVAL,
+				     "honeywell,temperature-bits %u invalid\n",
+				     hsc->temp_bits);
+	}
+	hsc->scan_len = hsc->full_len;
+
+	hsc->vdd = devm_regulator_get(dev, "vdd");
+	if (IS_ERR(hsc->vdd))
+		return dev_err_probe(dev, PTR_ERR(hsc->vdd),
+				     "can't get vdd supply\n");
+
+	ret = regulator_enable(hsc->vdd);
 	if (ret)
-		return dev_err_probe(dev, ret, "can't get vdd supply\n");
+		return dev_err_probe(dev, ret, "can't enable vdd supply\n");
+	hsc->ready_time = ktime_add_us(ktime_get(), HSC_STARTUP_TIME_US);
+
+	ret = devm_add_action_or_reset(dev, hsc_vdd_disable, hsc->vdd);
+	if (ret)
+		return ret;
 
 	hsc->outmin = hsc_func_spec[hsc->function].output_min;
 	hsc->outmax = hsc_func_spec[hsc->function].output_max;
 
-	tmp = div_s64(((s64)(hsc->pmax - hsc->pmin)) * MICRO,
-		      hsc->outmax - hsc->outmin);
-	hsc->p_scale = div_s64_rem(tmp, NANO, &hsc->p_scale_dec);
-	tmp = div_s64(((s64)hsc->pmin * (s64)(hsc->outmax - hsc->outmin)) * MICRO,
-		      hsc->pmax - hsc->pmin);
-	tmp -= (s64)hsc->outmin * MICRO;
-	hsc->p_offset = div_s64_rem(tmp, MICRO, &hsc->p_offset_dec);
+	if (variant >= 0) {
+		conv = &hsc_conv[variant][hsc->function];
+		hsc->p_scale = conv->scale;
+		hsc->p_scale_dec = conv->scale_dec;
+		hsc->p_offset = conv->offset;
+		hsc->p_offset_dec = conv->offset_dec;
+	} else {
+		hsc_calc_conv(hsc);
+	}
 
 	indio_dev->name = "hsc030pa";
-	indio_dev->modes = INDIO_DIRECT_MODE;
+	indio_dev->modes = INDIO_DIRECT_MODE | INDIO_BUFFER_SOFTWARE;
 	indio_dev->info = &hsc_info;
 	indio_dev->channels = hsc->chip->channels;
 	indio_dev->num_channels = hsc->chip->num_channels;
 
-	ret = devm_iio_triggered_buffer_setup(dev, indio_dev, NULL,
-					      hsc_trigger_handler, NULL);
+	ret = devm_iio_triggered_buffer_setup(dev, indio_dev,
+					      hsc_trigger_top_half,
+					      hsc_trigger_handler,
+					      &hsc_buffer_setup_ops);
+	if (ret)
+		return ret;
+
+	dev_set_drvdata(dev, indio_dev);
+	pm_runtime_get_noresume(dev);
+	pm_runtime_set_active(dev);
+	pm_runtime_enable(dev);
+	pm_runtime_set_autosuspend_delay(dev, HSC_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(dev);
+	pm_runtime_put(dev);
+
+	ret = devm_add_action_or_reset(dev, hsc_pm_disable, dev);
 	if (ret)
 		return ret;
 
@@ -539,3 +1362,4 @@ EXPORT_SYMBOL_NS(hsc_common_probe, IIO_HONEYWELL_HSC030PA);
 MODULE_AUTHOR("Petre Rodan <petre.rodan@subdimension.ro>");
 MODULE_DESCRIPTION("Honeywell HSC and SSC pressure sensor core driver");
 MODULE_LICENSE("GPL");
+MODULE_IMPORT_NS(IIO_RT_CAPTURE);
@@ -8,29 +8,80 @@
 #ifndef _HSC030PA_H
 #define _HSC030PA_H
 
+#include <linux/atomic.h>
+#include <linux/ktime.h>
+#include <linux/list.h>
+#include <linux/mutex.h>
+#include <linux/sched.h>
+#include <linux/seqlock.h>
 #include <linux/types.h>
 
 #include <linux/iio/iio.h>
 
+#include "../iio_rt_capture/iio_rt_capture.h"
+
 #define HSC_REG_MEASUREMENT_RD_SIZE 4
+#define HSC_REG_PRESSURE_RD_SIZE    2
+#define HSC_REG_TEMP8_RD_SIZE       3
 #define HSC_RESP_TIME_MS            2
+#define HSC_NUM_CHANNELS            3
+#define HSC_STARTUP_TIME_US         3000
+#define HSC_UPDATE_PERIOD_US        460
+#define HSC_RETRY_MAX               4
+#define HSC_RETRY_US                1000
+#define HSC_AUTOSUSPEND_DELAY_MS    1000
+#define HSC_COHERENCY_WINDOW_US     5000
+#define HSC_GROUP_MAX               16
+#define HSC_BURST_MAX               64
+#define HSC_BURST_TIMEOUT_US        5000
 
 struct device;
+struct dev_pm_ops;
 
 struct iio_chan_spec;
 struct iio_dev;
 
 struct hsc_data;
 struct hsc_chip_data;
+struct hsc_group;
+struct regulator;
 
 typedef int (*hsc_recv_fn)(struct hsc_data *);
+typedef int (*hsc_group_recv_fn)(struct hsc_data **members, unsigned int num);
+typedef unsigned int (*hsc_group_max_fn)(struct hsc_data *);
+typedef int (*hsc_recv_async_fn)(struct hsc_data *);
+
+/**
+ * struct hsc_bus_ops - transfers implemented by the bus specific drivers
+ * @recv: read data->read_len bytes into data->buffer
+ * @group_recv: read several chips sharing a bus in one go, optional
+ * @group_max: number of chips @group_recv can read in one go on the bus of
+ *             the given chip, optional if there is no limit
+ * @recv_async: queue a read of data->read_len bytes and return without
+ *              waiting for it, the transfer ends with hsc_async_complete().
+ *              optional
+ */
+struct hsc_bus_ops {
+	hsc_recv_fn recv;
+	hsc_group_recv_fn group_recv;
+	hsc_group_max_fn group_max;
+	hsc_recv_async_fn recv_async;
+};
 
 /**
  * struct hsc_data
  * @dev: current device structure
+ * @indio_dev: iio device this structure is private to
  * @chip: structure containing chip's channel properties
- * @recv_cb: function that implements the chip reads
+ * @lock: protects the conversion data and the coherency state
+ * @ops: transfer functions of the bus the chip sits on
+ * @bus_priv: private data of the bus specific driver
+ * @vdd: power supply, switched off while the device is runtime suspended
  * @is_valid: true if last transfer has been validated
+ * @read_len: number of bytes read by the next transfer
+ * @scan_len: number of bytes needed by the active scan mask
+ * @full_len: number of bytes that provide both pressure and temperature
+ * @temp_bits: temperature resolution, either 8 or 11 bits
  * @pmin: minimum measurable pressure limit
  * @pmax: maximum measurable pressure limit
  * @outmin: minimum raw pressure in counts (based on transfer function)
@@ -40,13 +91,50 @@ typedef int (*hsc_recv_fn)(struct hsc_data *);
  * @p_scale_dec: pressure scale, decimal places
  * @p_offset: pressure offset
  * @p_offset_dec: pressure offset, decimal places
+ * @ready_time: time after which the sensor provides valid conversions
+ * @conv_time: time at which the conversion in @buffer was read
+ * @unread: channels that were not yet reported out of @buffer via sysfs
+ * @coherency_us: maximum age of a conversion that can still be reported for
+ *                an unread channel, 0 to always trigger a new transfer
+ * @snap_lock: protects @snap, which is updated by the trigger handler or
+ *             by the completion of an asynchronous transfer
+ * @snap: latest sample acquired in buffered mode
+ * @snap.recvd: first four bytes of the transfer, cpu endian
+ * @snap.chans: channels that are valid in @snap.recvd, 0 if none
+ * @rt: real-time capture thread
+ * @group_capture: join a capture group when the buffer gets enabled
+ * @group: capture group, present while the buffer is enabled in group mode
+ * @group_node: entry in the member list of @group
+ * @pipelined: use asynchronous transfers in buffered mode
+ * @async_inflight: asynchronous transfers that have not completed yet
+ * @freerun: polling thread, present while a buffer is enabled without a
+ *           trigger
+ * @polling: skip the response time delay of the bus drivers, the stale flag
+ *           is used instead to tell if a conversion is new
+ * @retry_max: re-reads allowed when a triggered read finds a stale
+ *             conversion, 0 to drop the sample right away
+ * @retry_us: time budget for the re-reads of one triggered read
+ * @retry_stats: counters of the stale retries
+ * @retry_stats.reads: re-reads done
+ * @retry_stats.recovered: samples delivered thanks to a re-read
+ * @retry_stats.dropped: samples lost after the budget was spent
+ * @burst_len: number of pressure samples returned by a burst read
+ * @scan: channel values for buffered mode
  * @buffer: raw conversion data
  */
 struct hsc_data {
 	struct device *dev;
+	struct iio_dev *indio_dev;
 	const struct hsc_chip_data *chip;
-	hsc_recv_fn recv_cb;
+	struct mutex lock;
+	const struct hsc_bus_ops *ops;
+	void *bus_priv;
+	struct regulator *vdd;
 	bool is_valid;
+	u8 read_len;
+	u8 scan_len;
+	u8 full_len;
+	u32 temp_bits;
 	s32 pmin;
 	s32 pmax;
 	u32 outmin;
@@ -56,6 +144,31 @@ struct hsc_data {
 	s32 p_scale_dec;
 	s64 p_offset;
 	s32 p_offset_dec;
+	ktime_t ready_time;
+	ktime_t conv_time;
+	unsigned long unread;
+	u32 coherency_us;
+	seqlock_t snap_lock;
+	struct {
+		u32 recvd;
+		unsigned long chans;
+	} snap;
+	struct iio_rt_capture rt;
+	bool group_capture;
+	struct hsc_group *group;
+	struct list_head group_node;
+	bool pipelined;
+	atomic_t async_inflight;
+	struct task_struct *freerun;
+	bool polling;
+	u32 retry_max;
+	u32 retry_us;
+	struct {
+		unsigned long reads;
+		unsigned long recovered;
+		unsigned long dropped;
+	} retry_stats;
+	u32 burst_len;
 	struct {
 		__be16 chan[2];
 		s64 timestamp __aligned(8);
@@ -76,6 +189,14 @@ enum hsc_func_id {
 	HSC_FUNCTION_F,
 };
 
-int hsc_common_probe(struct device *dev, hsc_recv_fn recv);
+extern const struct iio_chan_spec hsc_channels[HSC_NUM_CHANNELS];
+extern const struct iio_chan_spec hsc_channels_t8[HSC_NUM_CHANNELS];
+
+extern const struct dev_pm_ops hsc_pm_ops;
+
+int hsc_common_probe(struct device *dev, const struct hsc_bus_ops *ops,
+		     void *bus_priv);
+void hsc_async_complete(struct hsc_data *data, const u8 *rx, int status,
+			s64 timestamp);
 
 #endif
@@ -12,8 +12,10 @@
 #include <linux/device.h>
 #include <linux/errno.h>
 #include <linux/i2c.h>
+#include <linux/minmax.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
+#include <linux/pm.h>
 #include <linux/types.h>
 
 #include <linux/iio/iio.h>
@@ -26,11 +28,12 @@ static int hsc_i2c_recv(struct hsc_data *data)
 	struct i2c_msg msg;
 	int ret;
 
-	msleep_interruptible(HSC_RESP_TIME_MS);
+	if (!data->polling)
+		msleep_interruptible(HSC_RESP_TIME_MS);
 
 	msg.addr = client->addr;
 	msg.flags = client->flags | I2C_M_RD;
-	msg.len = HSC_REG_MEASUREMENT_RD_SIZE;
+	msg.len = data->read_len;
 	msg.buf = data->buffer;
 
 	ret = i2c_transfer(client->adapter, &msg, 1);
@@ -38,12 +41,68 @@ static int hsc_i2c_recv(struct hsc_data *data)
 	return (ret == 2) ? 0 : ret;
 }
 
+/*
+ * all the members of a capture group sit on the same adapter, so they are
+ * read by one i2c_transfer() with one message per sensor. the bus is
+ * arbitrated once and the messages are separated by repeated starts. the
+ * caller waits for the response time once for all the members.
+ */
+static int hsc_i2c_group_recv(struct hsc_data **members, unsigned int num)
+{
+	struct i2c_msg msgs[HSC_GROUP_MAX];
+	struct i2c_client *client;
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < num; i++) {
+		client = to_i2c_client(members[i]->dev);
+		msgs[i].addr = client->addr;
+		msgs[i].flags = client->flags | I2C_M_RD;
+		msgs[i].len = members[i]->read_len;
+		msgs[i].buf = members[i]->buffer;
+	}
+
+	ret = i2c_transfer(client->adapter, msgs, num);
+	if (ret < 0)
+		return ret;
+
+	return ret == num ? 0 : -EIO;
+}
+
+/*
+ * adapters that can not do repeated starts, or that only combine a write
+ * with a read, get one message per transfer
+ */
+static unsigned int hsc_i2c_group_max(struct hsc_data *data)
+{
+	const struct i2c_adapter_quirks *quirks;
+
+	quirks = to_i2c_client(data->dev)->adapter->quirks;
+	if (!quirks)
+		return HSC_GROUP_MAX;
+
+	if (quirks->flags & (I2C_AQ_NO_REP_START | I2C_AQ_COMB))
+		return 1;
+
+	if (quirks->max_num_msgs)
+		return min_t(unsigned int, quirks->max_num_msgs,
+			     HSC_GROUP_MAX);
+
+	return HSC_GROUP_MAX;
+}
+
+static const struct hsc_bus_ops hsc_i2c_ops = {
+	.recv = hsc_i2c_recv,
+	.group_recv = hsc_i2c_group_recv,
+	.group_max = hsc_i2c_group_max,
+};
+
 static int hsc_i2c_probe(struct i2c_client *client)
 {
 	if (!i2c_check_functionality(client->adapter, I2C_FUNC_I2C))
 		return -EOPNOTSUPP;
 
-	return hsc_common_probe(&client->dev, hsc_i2c_recv);
+	return hsc_common_probe(&client->dev, &hsc_i2c_ops, NULL);
 }
 
 static const struct of_device_id hsc_i2c_match[] = {
@@ -62,6 +121,7 @@ static struct i2c_driver hsc_i2c_driver = {
 	.driver = {
 		.name = "hsc030pa",
 		.of_match_table = hsc_i2c_match,
+		.pm = pm_ptr(&hsc_pm_ops),
 	},
 	.probe = hsc_i2c_probe,
 	.id_table = hsc_i2c_id,
@@ -8,34 +8,199 @@
  * Datasheet: https://prod-edam.honeywell.com/content/dam/honeywell-edam/sps/siot/en-us/products/sensors/pressure-sensors/common/documents/sps-siot-sleep-mode-technical-note-008286-1-en-ciid-155793.pdf
  */
 
+#include <linux/bitops.h>
 #include <linux/delay.h>
 #include <linux/device.h>
+#include <linux/errno.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
+#include <linux/pm.h>
+#include <linux/slab.h>
 #include <linux/spi/spi.h>
 #include <linux/stddef.h>
+#include <linux/string.h>
 #include <linux/types.h>
 
 #include <linux/iio/iio.h>
 
 #include "hsc030pa.h"
 
+#define HSC_SPI_SLOTS 2
+
+/**
+ * struct hsc_spi_msg - read that is validated once and reused
+ * @msg: spi message
+ * @xfer: the single rx transfer of @msg
+ * @len: transfer length @msg was prepared for, 0 if not prepared
+ */
+struct hsc_spi_msg {
+	struct spi_message msg;
+	struct spi_transfer xfer;
+	unsigned int len;
+};
+
+/**
+ * struct hsc_spi_slot - asynchronous read in flight
+ * @m: message used by this slot
+ * @data: chip the read belongs to
+ * @timestamp: time the read was queued at
+ * @rx: receive buffer, the chip's buffer is used by synchronous reads
+ */
+struct hsc_spi_slot {
+	struct hsc_spi_msg m;
+	struct hsc_data *data;
+	s64 timestamp;
+	u8 rx[HSC_REG_MEASUREMENT_RD_SIZE] __aligned(IIO_DMA_MINALIGN);
+};
+
+/**
+ * struct hsc_spi - spi specific state
+ * @sync: message used by hsc_spi_recv()
+ * @slot: asynchronous reads, two of them let the next read be queued while
+ *        the previous one is still being pushed
+ * @busy: bitmap of the slots that are in flight
+ */
+struct hsc_spi {
+	struct hsc_spi_msg sync;
+	struct hsc_spi_slot slot[HSC_SPI_SLOTS];
+	unsigned long busy;
+};
+
+/*
+ * the message is only rebuilt when the transfer length changes, which
+ * happens when a buffer with a different scan mask is enabled
+ */
+static int hsc_spi_prepare(struct spi_device *spi, struct hsc_spi_msg *m,
+			   void *rx, unsigned int len)
+{
+	int ret;
+
+	if (m->len == len)
+		return 0;
+
+	if (m->len)
+		spi_unoptimize_message(&m->msg);
+	m->len = 0;
+
+	m->xfer.rx_buf = rx;
+	m->xfer.len = len;
+	spi_message_init_with_transfers(&m->msg, &m->xfer, 1);
+
+	ret = spi_optimize_message(spi, &m->msg);
+	if (ret)
+		return ret;
+
+	m->len = len;
+
+	return 0;
+}
+
+static void hsc_spi_unprepare(void *arg)
+{
+	struct hsc_spi *st = arg;
+	unsigned int i;
+
+	if (st->sync.len)
+		spi_unoptimize_message(&st->sync.msg);
+
+	for (i = 0; i < HSC_SPI_SLOTS; i++)
+		if (st->slot[i].m.len)
+			spi_unoptimize_message(&st->slot[i].m.msg);
+}
+
 static int hsc_spi_recv(struct hsc_data *data)
 {
 	struct spi_device *spi = to_spi_device(data->dev);
-	struct spi_transfer xfer = {
-		.tx_buf = NULL,
-		.rx_buf = data->buffer,
-		.len = HSC_REG_MEASUREMENT_RD_SIZE,
-	};
-
-	msleep_interruptible(HSC_RESP_TIME_MS);
-	return spi_sync_transfer(spi, &xfer, 1);
+	struct hsc_spi *st = data->bus_priv;
+	int ret;
+
+	ret = hsc_spi_prepare(spi, &st->sync, data->buffer, data->read_len);
+	if (ret)
+		return ret;
+
+	if (!data->polling)
+		msleep_interruptible(HSC_RESP_TIME_MS);
+
+	return spi_sync(spi, &st->sync.msg);
+}
+
+/* runs in the context the spi controller completes messages in */
+static void hsc_spi_complete(void *context)
+{
+	struct hsc_spi_slot *slot = context;
+	struct hsc_data *data = slot->data;
+	struct hsc_spi *st = data->bus_priv;
+	u8 rx[HSC_REG_MEASUREMENT_RD_SIZE];
+	int status = slot->m.msg.status;
+	s64 timestamp = slot->timestamp;
+
+	/* hand the slot back before the sample is pushed */
+	memcpy(rx, slot->rx, sizeof(rx));
+	clear_bit_unlock(slot - st->slot, &st->busy);
+
+	hsc_async_complete(data, rx, status, timestamp);
+}
+
+/*
+ * unlike hsc_spi_recv() there is no HSC_RESP_TIME_MS delay, the trigger
+ * period is expected to be longer than the conversion time of the chip.
+ */
+static int hsc_spi_recv_async(struct hsc_data *data)
+{
+	struct spi_device *spi = to_spi_device(data->dev);
+	struct hsc_spi *st = data->bus_priv;
+	struct hsc_spi_slot *slot;
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < HSC_SPI_SLOTS; i++)
+		if (!test_and_set_bit_lock(i, &st->busy))
+			break;
+
+	if (i == HSC_SPI_SLOTS)
+		return -EBUSY;
+
+	slot = &st->slot[i];
+	ret = hsc_spi_prepare(spi, &slot->m, slot->rx, data->read_len);
+	if (ret)
+		goto out_release;
+
+	slot->data = data;
+	slot->m.msg.complete = hsc_spi_complete;
+	slot->m.msg.context = slot;
+	slot->timestamp = iio_get_time_ns(data->indio_dev);
+
+	ret = spi_async(spi, &slot->m.msg);
+	if (ret)
+		goto out_release;
+
+	return 0;
+
+out_release:
+	clear_bit_unlock(i, &st->busy);
+	return ret;
 }
 
+static const struct hsc_bus_ops hsc_spi_ops = {
+	.recv = hsc_spi_recv,
+	.recv_async = hsc_spi_recv_async,
+};
+
 static int hsc_spi_probe(struct spi_device *spi)
 {
-	return hsc_common_probe(&spi->dev, hsc_spi_recv);
+	struct hsc_spi *st;
+	int ret;
+
+	st = devm_kzalloc(&spi->dev, sizeof(*st), GFP_KERNEL);
+	if (!st)
+		return -ENOMEM;
+
+	/* registered first so it runs after the iio device is gone */
+	ret = devm_add_action_or_reset(&spi->dev, hsc_spi_unprepare, st);
+	if (ret)
+		return ret;
+
+	return hsc_common_probe(&spi->dev, &hsc_spi_ops, st);
 }
 
 static const struct of_device_id hsc_spi_match[] = {
@@ -54,6 +219,7 @@ static struct spi_driver hsc_spi_driver = {
 	.driver = {
 		.name = "hsc030pa",
 		.of_match_table = hsc_spi_match,
+		.pm = pm_ptr(&hsc_pm_ops),
 	},
 	.probe = hsc_spi_probe,
 	.id_table = hsc_spi_id,
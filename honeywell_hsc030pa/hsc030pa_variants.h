@@ -0,0 +1,732 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Honeywell TruStability HSC Series pressure/temperature sensor
+ *
+ * generated by scripts/parse_variants_table.sh from hsc_variants.txt,
+ * do not edit
+ */
+
+#ifndef _HSC030PA_VARIANTS_H
+#define _HSC030PA_VARIANTS_H
+
+#include <linux/types.h>
+
+#include "hsc030pa.h"
+
+struct hsc_func_spec {
+	u32 output_min;
+	u32 output_max;
+};
+
+/*
+ * function A: 10% - 90% of 2^14
+ * function B:  5% - 95% of 2^14
+ * function C:  5% - 85% of 2^14
+ * function F:  4% - 94% of 2^14
+ */
+static const struct hsc_func_spec hsc_func_spec[] = {
+	[HSC_FUNCTION_A] = { .output_min = 1638, .output_max = 14746 },
+	[HSC_FUNCTION_B] = { .output_min =  819, .output_max = 15565 },
+	[HSC_FUNCTION_C] = { .output_min =  819, .output_max = 13926 },
+	[HSC_FUNCTION_F] = { .output_min =  655, .output_max = 15401 },
+};
+
+enum hsc_variants {
+	HSC001BA = 0x00, HSC1_6BA = 0x01, HSC2_5BA = 0x02, HSC004BA = 0x03,
+	HSC006BA = 0x04, HSC010BA = 0x05, HSC1_6MD = 0x06, HSC2_5MD = 0x07,
+	HSC004MD = 0x08, HSC006MD = 0x09, HSC010MD = 0x0a, HSC016MD = 0x0b,
+	HSC025MD = 0x0c, HSC040MD = 0x0d, HSC060MD = 0x0e, HSC100MD = 0x0f,
+	HSC160MD = 0x10, HSC250MD = 0x11, HSC400MD = 0x12, HSC600MD = 0x13,
+	HSC001BD = 0x14, HSC1_6BD = 0x15, HSC2_5BD = 0x16, HSC004BD = 0x17,
+	HSC2_5MG = 0x18, HSC004MG = 0x19, HSC006MG = 0x1a, HSC010MG = 0x1b,
+	HSC016MG = 0x1c, HSC025MG = 0x1d, HSC040MG = 0x1e, HSC060MG = 0x1f,
+	HSC100MG = 0x20, HSC160MG = 0x21, HSC250MG = 0x22, HSC400MG = 0x23,
+	HSC600MG = 0x24, HSC001BG = 0x25, HSC1_6BG = 0x26, HSC2_5BG = 0x27,
+	HSC004BG = 0x28, HSC006BG = 0x29, HSC010BG = 0x2a, HSC100KA = 0x2b,
+	HSC160KA = 0x2c, HSC250KA = 0x2d, HSC400KA = 0x2e, HSC600KA = 0x2f,
+	HSC001GA = 0x30, HSC160LD = 0x31, HSC250LD = 0x32, HSC400LD = 0x33,
+	HSC600LD = 0x34, HSC001KD = 0x35, HSC1_6KD = 0x36, HSC2_5KD = 0x37,
+	HSC004KD = 0x38, HSC006KD = 0x39, HSC010KD = 0x3a, HSC016KD = 0x3b,
+	HSC025KD = 0x3c, HSC040KD = 0x3d, HSC060KD = 0x3e, HSC100KD = 0x3f,
+	HSC160KD = 0x40, HSC250KD = 0x41, HSC400KD = 0x42, HSC250LG = 0x43,
+	HSC400LG = 0x44, HSC600LG = 0x45, HSC001KG = 0x46, HSC1_6KG = 0x47,
+	HSC2_5KG = 0x48, HSC004KG = 0x49, HSC006KG = 0x4a, HSC010KG = 0x4b,
+	HSC016KG = 0x4c, HSC025KG = 0x4d, HSC040KG = 0x4e, HSC060KG = 0x4f,
+	HSC100KG = 0x50, HSC160KG = 0x51, HSC250KG = 0x52, HSC400KG = 0x53,
+	HSC600KG = 0x54, HSC001GG = 0x55, HSC015PA = 0x56, HSC030PA = 0x57,
+	HSC060PA = 0x58, HSC100PA = 0x59, HSC150PA = 0x5a, HSC0_5ND = 0x5b,
+	HSC001ND = 0x5c, HSC002ND = 0x5d, HSC004ND = 0x5e, HSC005ND = 0x5f,
+	HSC010ND = 0x60, HSC020ND = 0x61, HSC030ND = 0x62, HSC001PD = 0x63,
+	HSC005PD = 0x64, HSC015PD = 0x65, HSC030PD = 0x66, HSC060PD = 0x67,
+	HSC001NG = 0x68, HSC002NG = 0x69, HSC004NG = 0x6a, HSC005NG = 0x6b,
+	HSC010NG = 0x6c, HSC020NG = 0x6d, HSC030NG = 0x6e, HSC001PG = 0x6f,
+	HSC005PG = 0x70, HSC015PG = 0x71, HSC030PG = 0x72, HSC060PG = 0x73,
+	HSC100PG = 0x74, HSC150PG = 0x75, HSC_VARIANTS_MAX
+};
+
+static const char * const hsc_triplet_variants[HSC_VARIANTS_MAX] = {
+	[HSC001BA] = "001BA", [HSC1_6BA] = "1.6BA", [HSC2_5BA] = "2.5BA",
+	[HSC004BA] = "004BA", [HSC006BA] = "006BA", [HSC010BA] = "010BA",
+	[HSC1_6MD] = "1.6MD", [HSC2_5MD] = "2.5MD", [HSC004MD] = "004MD",
+	[HSC006MD] = "006MD", [HSC010MD] = "010MD", [HSC016MD] = "016MD",
+	[HSC025MD] = "025MD", [HSC040MD] = "040MD", [HSC060MD] = "060MD",
+	[HSC100MD] = "100MD", [HSC160MD] = "160MD", [HSC250MD] = "250MD",
+	[HSC400MD] = "400MD", [HSC600MD] = "600MD", [HSC001BD] = "001BD",
+	[HSC1_6BD] = "1.6BD", [HSC2_5BD] = "2.5BD", [HSC004BD] = "004BD",
+	[HSC2_5MG] = "2.5MG", [HSC004MG] = "004MG", [HSC006MG] = "006MG",
+	[HSC010MG] = "010MG", [HSC016MG] = "016MG", [HSC025MG] = "025MG",
+	[HSC040MG] = "040MG", [HSC060MG] = "060MG", [HSC100MG] = "100MG",
+	[HSC160MG] = "160MG", [HSC250MG] = "250MG", [HSC400MG] = "400MG",
+	[HSC600MG] = "600MG", [HSC001BG] = "001BG", [HSC1_6BG] = "1.6BG",
+	[HSC2_5BG] = "2.5BG", [HSC004BG] = "004BG", [HSC006BG] = "006BG",
+	[HSC010BG] = "010BG", [HSC100KA] = "100KA", [HSC160KA] = "160KA",
+	[HSC250KA] = "250KA", [HSC400KA] = "400KA", [HSC600KA] = "600KA",
+	[HSC001GA] = "001GA", [HSC160LD] = "160LD", [HSC250LD] = "250LD",
+	[HSC400LD] = "400LD", [HSC600LD] = "600LD", [HSC001KD] = "001KD",
+	[HSC1_6KD] = "1.6KD", [HSC2_5KD] = "2.5KD", [HSC004KD] = "004KD",
+	[HSC006KD] = "006KD", [HSC010KD] = "010KD", [HSC016KD] = "016KD",
+	[HSC025KD] = "025KD", [HSC040KD] = "040KD", [HSC060KD] = "060KD",
+	[HSC100KD] = "100KD", [HSC160KD] = "160KD", [HSC250KD] = "250KD",
+	[HSC400KD] = "400KD", [HSC250LG] = "250LG", [HSC400LG] = "400LG",
+	[HSC600LG] = "600LG", [HSC001KG] = "001KG", [HSC1_6KG] = "1.6KG",
+	[HSC2_5KG] = "2.5KG", [HSC004KG] = "004KG", [HSC006KG] = "006KG",
+	[HSC010KG] = "010KG", [HSC016KG] = "016KG", [HSC025KG] = "025KG",
+	[HSC040KG] = "040KG", [HSC060KG] = "060KG", [HSC100KG] = "100KG",
+	[HSC160KG] = "160KG", [HSC250KG] = "250KG", [HSC400KG] = "400KG",
+	[HSC600KG] = "600KG", [HSC001GG] = "001GG", [HSC015PA] = "015PA",
+	[HSC030PA] = "030PA", [HSC060PA] = "060PA", [HSC100PA] = "100PA",
+	[HSC150PA] = "150PA", [HSC0_5ND] = "0.5ND", [HSC001ND] = "001ND",
+	[HSC002ND] = "002ND", [HSC004ND] = "004ND", [HSC005ND] = "005ND",
+	[HSC010ND] = "010ND", [HSC020ND] = "020ND", [HSC030ND] = "030ND",
+	[HSC001PD] = "001PD", [HSC005PD] = "005PD", [HSC015PD] = "015PD",
+	[HSC030PD] = "030PD", [HSC060PD] = "060PD", [HSC001NG] = "001NG",
+	[HSC002NG] = "002NG", [HSC004NG] = "004NG", [HSC005NG] = "005NG",
+	[HSC010NG] = "010NG", [HSC020NG] = "020NG", [HSC030NG] = "030NG",
+	[HSC001PG] = "001PG", [HSC005PG] = "005PG", [HSC015PG] = "015PG",
+	[HSC030PG] = "030PG", [HSC060PG] = "060PG", [HSC100PG] = "100PG",
+	[HSC150PG] = "150PG",
+};
+
+/**
+ * struct hsc_range_config - list of pressure ranges based on nomenclature
+ * @pmin: lowest pressure that can be measured
+ * @pmax: highest pressure that can be measured
+ */
+struct hsc_range_config {
+	const s32 pmin;
+	const s32 pmax;
+};
+
+/* All min max limits have been converted to pascals */
+static const struct hsc_range_config hsc_range_config[HSC_VARIANTS_MAX] = {
+	[HSC001BA] = { .pmin =       0, .pmax =  100000 },
+	[HSC1_6BA] = { .pmin =       0, .pmax =  160000 },
+	[HSC2_5BA] = { .pmin =       0, .pmax =  250000 },
+	[HSC004BA] = { .pmin =       0, .pmax =  400000 },
+	[HSC006BA] = { .pmin =       0, .pmax =  600000 },
+	[HSC010BA] = { .pmin =       0, .pmax = 1000000 },
+	[HSC1_6MD] = { .pmin =    -160, .pmax =     160 },
+	[HSC2_5MD] = { .pmin =    -250, .pmax =     250 },
+	[HSC004MD] = { .pmin =    -400, .pmax =     400 },
+	[HSC006MD] = { .pmin =    -600, .pmax =     600 },
+	[HSC010MD] = { .pmin =   -1000, .pmax =    1000 },
+	[HSC016MD] = { .pmin =   -1600, .pmax =    1600 },
+	[HSC025MD] = { .pmin =   -2500, .pmax =    2500 },
+	[HSC040MD] = { .pmin =   -4000, .pmax =    4000 },
+	[HSC060MD] = { .pmin =   -6000, .pmax =    6000 },
+	[HSC100MD] = { .pmin =  -10000, .pmax =   10000 },
+	[HSC160MD] = { .pmin =  -16000, .pmax =   16000 },
+	[HSC250MD] = { .pmin =  -25000, .pmax =   25000 },
+	[HSC400MD] = { .pmin =  -40000, .pmax =   40000 },
+	[HSC600MD] = { .pmin =  -60000, .pmax =   60000 },
+	[HSC001BD] = { .pmin = -100000, .pmax =  100000 },
+	[HSC1_6BD] = { .pmin = -160000, .pmax =  160000 },
+	[HSC2_5BD] = { .pmin = -250000, .pmax =  250000 },
+	[HSC004BD] = { .pmin = -400000, .pmax =  400000 },
+	[HSC2_5MG] = { .pmin =       0, .pmax =     250 },
+	[HSC004MG] = { .pmin =       0, .pmax =     400 },
+	[HSC006MG] = { .pmin =       0, .pmax =     600 },
+	[HSC010MG] = { .pmin =       0, .pmax =    1000 },
+	[HSC016MG] = { .pmin =       0, .pmax =    1600 },
+	[HSC025MG] = { .pmin =       0, .pmax =    2500 },
+	[HSC040MG] = { .pmin =       0, .pmax =    4000 },
+	[HSC060MG] = { .pmin =       0, .pmax =    6000 },
+	[HSC100MG] = { .pmin =       0, .pmax =   10000 },
+	[HSC160MG] = { .pmin =       0, .pmax =   16000 },
+	[HSC250MG] = { .pmin =       0, .pmax =   25000 },
+	[HSC400MG] = { .pmin =       0, .pmax =   40000 },
+	[HSC600MG] = { .pmin =       0, .pmax =   60000 },
+	[HSC001BG] = { .pmin =       0, .pmax =  100000 },
+	[HSC1_6BG] = { .pmin =       0, .pmax =  160000 },
+	[HSC2_5BG] = { .pmin =       0, .pmax =  250000 },
+	[HSC004BG] = { .pmin =       0, .pmax =  400000 },
+	[HSC006BG] = { .pmin =       0, .pmax =  600000 },
+	[HSC010BG] = { .pmin =       0, .pmax = 1000000 },
+	[HSC100KA] = { .pmin =       0, .pmax =  100000 },
+	[HSC160KA] = { .pmin =       0, .pmax =  160000 },
+	[HSC250KA] = { .pmin =       0, .pmax =  250000 },
+	[HSC400KA] = { .pmin =       0, .pmax =  400000 },
+	[HSC600KA] = { .pmin =       0, .pmax =  600000 },
+	[HSC001GA] = { .pmin =       0, .pmax = 1000000 },
+	[HSC160LD] = { .pmin =    -160, .pmax =     160 },
+	[HSC250LD] = { .pmin =    -250, .pmax =     250 },
+	[HSC400LD] = { .pmin =    -400, .pmax =     400 },
+	[HSC600LD] = { .pmin =    -600, .pmax =     600 },
+	[HSC001KD] = { .pmin =   -1000, .pmax =    1000 },
+	[HSC1_6KD] = { .pmin =   -1600, .pmax =    1600 },
+	[HSC2_5KD] = { .pmin =   -2500, .pmax =    2500 },
+	[HSC004KD] = { .pmin =   -4000, .pmax =    4000 },
+	[HSC006KD] = { .pmin =   -6000, .pmax =    6000 },
+	[HSC010KD] = { .pmin =  -10000, .pmax =   10000 },
+	[HSC016KD] = { .pmin =  -16000, .pmax =   16000 },
+	[HSC025KD] = { .pmin =  -25000, .pmax =   25000 },
+	[HSC040KD] = { .pmin =  -40000, .pmax =   40000 },
+	[HSC060KD] = { .pmin =  -60000, .pmax =   60000 },
+	[HSC100KD] = { .pmin = -100000, .pmax =  100000 },
+	[HSC160KD] = { .pmin = -160000, .pmax =  160000 },
+	[HSC250KD] = { .pmin = -250000, .pmax =  250000 },
+	[HSC400KD] = { .pmin = -400000, .pmax =  400000 },
+	[HSC250LG] = { .pmin =       0, .pmax =     250 },
+	[HSC400LG] = { .pmin =       0, .pmax =     400 },
+	[HSC600LG] = { .pmin =       0, .pmax =     600 },
+	[HSC001KG] = { .pmin =       0, .pmax =    1000 },
+	[HSC1_6KG] = { .pmin =       0, .pmax =    1600 },
+	[HSC2_5KG] = { .pmin =       0, .pmax =    2500 },
+	[HSC004KG] = { .pmin =       0, .pmax =    4000 },
+	[HSC006KG] = { .pmin =       0, .pmax =    6000 },
+	[HSC010KG] = { .pmin =       0, .pmax =   10000 },
+	[HSC016KG] = { .pmin =       0, .pmax =   16000 },
+	[HSC025KG] = { .pmin =       0, .pmax =   25000 },
+	[HSC040KG] = { .pmin =       0, .pmax =   40000 },
+	[HSC060KG] = { .pmin =       0, .pmax =   60000 },
+	[HSC100KG] = { .pmin =       0, .pmax =  100000 },
+	[HSC160KG] = { .pmin =       0, .pmax =  160000 },
+	[HSC250KG] = { .pmin =       0, .pmax =  250000 },
+	[HSC400KG] = { .pmin =       0, .pmax =  400000 },
+	[HSC600KG] = { .pmin =       0, .pmax =  600000 },
+	[HSC001GG] = { .pmin =       0, .pmax = 1000000 },
+	[HSC015PA] = { .pmin =       0, .pmax =  103421 },
+	[HSC030PA] = { .pmin =       0, .pmax =  206843 },
+	[HSC060PA] = { .pmin =       0, .pmax =  413685 },
+	[HSC100PA] = { .pmin =       0, .pmax =  689476 },
+	[HSC150PA] = { .pmin =       0, .pmax = 1034214 },
+	[HSC0_5ND] = { .pmin =    -125, .pmax =     125 },
+	[HSC001ND] = { .pmin =    -249, .pmax =     249 },
+	[HSC002ND] = { .pmin =    -498, .pmax =     498 },
+	[HSC004ND] = { .pmin =    -996, .pmax =     996 },
+	[HSC005ND] = { .pmin =   -1245, .pmax =    1245 },
+	[HSC010ND] = { .pmin =   -2491, .pmax =    2491 },
+	[HSC020ND] = { .pmin =   -4982, .pmax =    4982 },
+	[HSC030ND] = { .pmin =   -7473, .pmax =    7473 },
+	[HSC001PD] = { .pmin =   -6895, .pmax =    6895 },
+	[HSC005PD] = { .pmin =  -34474, .pmax =   34474 },
+	[HSC015PD] = { .pmin = -103421, .pmax =  103421 },
+	[HSC030PD] = { .pmin = -206843, .pmax =  206843 },
+	[HSC060PD] = { .pmin = -413685, .pmax =  413685 },
+	[HSC001NG] = { .pmin =       0, .pmax =     249 },
+	[HSC002NG] = { .pmin =       0, .pmax =     498 },
+	[HSC004NG] = { .pmin =       0, .pmax =     996 },
+	[HSC005NG] = { .pmin =       0, .pmax =    1245 },
+	[HSC010NG] = { .pmin =       0, .pmax =    2491 },
+	[HSC020NG] = { .pmin =       0, .pmax =    4982 },
+	[HSC030NG] = { .pmin =       0, .pmax =    7473 },
+	[HSC001PG] = { .pmin =       0, .pmax =    6895 },
+	[HSC005PG] = { .pmin =       0, .pmax =   34474 },
+	[HSC015PG] = { .pmin =       0, .pmax =  103421 },
+	[HSC030PG] = { .pmin =       0, .pmax =  206843 },
+	[HSC060PG] = { .pmin =       0, .pmax =  413685 },
+	[HSC100PG] = { .pmin =       0, .pmax =  689476 },
+	[HSC150PG] = { .pmin =       0, .pmax = 1034214 },
+};
+
+/**
+ * struct hsc_conv - pressure scale and offset, precomputed for every
+ *                   variant and transfer function
+ * @scale: pressure scale, integer part
+ * @scale_dec: pressure scale, nano units
+ * @offset: pressure offset, integer part
+ * @offset_dec: pressure offset, micro units
+ */
+struct hsc_conv {
+	s64 scale;
+	s32 scale_dec;
+	s64 offset;
+	s32 offset_dec;
+};
+
+static const struct hsc_conv hsc_conv[HSC_VARIANTS_MAX][HSC_FUNCTION_F + 1] = {
+	[HSC001BA][HSC_FUNCTION_A] = { 0,   7628928,  -1638,       0 },
+	[HSC001BA][HSC_FUNCTION_B] = { 0,   6781500,   -819,       0 },
+	[HSC001BA][HSC_FUNCTION_C] = { 0,   7629510,   -819,       0 },
+	[HSC001BA][HSC_FUNCTION_F] = { 0,   6781500,   -655,       0 },
+	[HSC1_6BA][HSC_FUNCTION_A] = { 0,  12206286,  -1638,       0 },
+	[HSC1_6BA][HSC_FUNCTION_B] = { 0,  10850400,   -819,       0 },
+	[HSC1_6BA][HSC_FUNCTION_C] = { 0,  12207217,   -819,       0 },
+	[HSC1_6BA][HSC_FUNCTION_F] = { 0,  10850400,   -655,       0 },
+	[HSC2_5BA][HSC_FUNCTION_A] = { 0,  19072322,  -1638,       0 },
+	[HSC2_5BA][HSC_FUNCTION_B] = { 0,  16953750,   -819,       0 },
+	[HSC2_5BA][HSC_FUNCTION_C] = { 0,  19073777,   -819,       0 },
+	[HSC2_5BA][HSC_FUNCTION_F] = { 0,  16953750,   -655,       0 },
+	[HSC004BA][HSC_FUNCTION_A] = { 0,  30515715,  -1638,       0 },
+	[HSC004BA][HSC_FUNCTION_B] = { 0,  27126000,   -819,       0 },
+	[HSC004BA][HSC_FUNCTION_C] = { 0,  30518043,   -819,       0 },
+	[HSC004BA][HSC_FUNCTION_F] = { 0,  27126000,   -655,       0 },
+	[HSC006BA][HSC_FUNCTION_A] = { 0,  45773573,  -1638,       0 },
+	[HSC006BA][HSC_FUNCTION_B] = { 0,  40689000,   -819,       0 },
+	[HSC006BA][HSC_FUNCTION_C] = { 0,  45777065,   -819,       0 },
+	[HSC006BA][HSC_FUNCTION_F] = { 0,  40689000,   -655,       0 },
+	[HSC010BA][HSC_FUNCTION_A] = { 0,  76289288,  -1638,       0 },
+	[HSC010BA][HSC_FUNCTION_B] = { 0,  67815000,   -819,       0 },
+	[HSC010BA][HSC_FUNCTION_C] = { 0,  76295109,   -819,       0 },
+	[HSC010BA][HSC_FUNCTION_F] = { 0,  67815000,   -655,       0 },
+	[HSC1_6MD][HSC_FUNCTION_A] = { 0,     24412,  -8192,       0 },
+	[HSC1_6MD][HSC_FUNCTION_B] = { 0,     21700,  -8192,       0 },
+	[HSC1_6MD][HSC_FUNCTION_C] = { 0,     24414,  -7372, -500000 },
+	[HSC1_6MD][HSC_FUNCTION_F] = { 0,     21700,  -8028,       0 },
+	[HSC2_5MD][HSC_FUNCTION_A] = { 0,     38144,  -8192,       0 },
+	[HSC2_5MD][HSC_FUNCTION_B] = { 0,     33907,  -8192,       0 },
+	[HSC2_5MD][HSC_FUNCTION_C] = { 0,     38147,  -7372, -500000 },
+	[HSC2_5MD][HSC_FUNCTION_F] = { 0,     33907,  -8028,       0 },
+	[HSC004MD][HSC_FUNCTION_A] = { 0,     61031,  -8192,       0 },
+	[HSC004MD][HSC_FUNCTION_B] = { 0,     54252,  -8192,       0 },
+	[HSC004MD][HSC_FUNCTION_C] = { 0,     61036,  -7372, -500000 },
+	[HSC004MD][HSC_FUNCTION_F] = { 0,     54252,  -8028,       0 },
+	[HSC006MD][HSC_FUNCTION_A] = { 0,     91547,  -8192,       0 },
+	[HSC006MD][HSC_FUNCTION_B] = { 0,     81378,  -8192,       0 },
+	[HSC006MD][HSC_FUNCTION_C] = { 0,     91554,  -7372, -500000 },
+	[HSC006MD][HSC_FUNCTION_F] = { 0,     81378,  -8028,       0 },
+	[HSC010MD][HSC_FUNCTION_A] = { 0,    152578,  -8192,       0 },
+	[HSC010MD][HSC_FUNCTION_B] = { 0,    135630,  -8192,       0 },
+	[HSC010MD][HSC_FUNCTION_C] = { 0,    152590,  -7372, -500000 },
+	[HSC010MD][HSC_FUNCTION_F] = { 0,    135630,  -8028,       0 },
+	[HSC016MD][HSC_FUNCTION_A] = { 0,    244125,  -8192,       0 },
+	[HSC016MD][HSC_FUNCTION_B] = { 0,    217008,  -8192,       0 },
+	[HSC016MD][HSC_FUNCTION_C] = { 0,    244144,  -7372, -500000 },
+	[HSC016MD][HSC_FUNCTION_F] = { 0,    217008,  -8028,       0 },
+	[HSC025MD][HSC_FUNCTION_A] = { 0,    381446,  -8192,       0 },
+	[HSC025MD][HSC_FUNCTION_B] = { 0,    339075,  -8192,       0 },
+	[HSC025MD][HSC_FUNCTION_C] = { 0,    381475,  -7372, -500000 },
+	[HSC025MD][HSC_FUNCTION_F] = { 0,    339075,  -8028,       0 },
+	[HSC040MD][HSC_FUNCTION_A] = { 0,    610314,  -8192,       0 },
+	[HSC040MD][HSC_FUNCTION_B] = { 0,    542520,  -8192,       0 },
+	[HSC040MD][HSC_FUNCTION_C] = { 0,    610360,  -7372, -500000 },
+	[HSC040MD][HSC_FUNCTION_F] = { 0,    542520,  -8028,       0 },
+	[HSC060MD][HSC_FUNCTION_A] = { 0,    915471,  -8192,       0 },
+	[HSC060MD][HSC_FUNCTION_B] = { 0,    813780,  -8192,       0 },
+	[HSC060MD][HSC_FUNCTION_C] = { 0,    915541,  -7372, -500000 },
+	[HSC060MD][HSC_FUNCTION_F] = { 0,    813780,  -8028,       0 },
+	[HSC100MD][HSC_FUNCTION_A] = { 0,   1525785,  -8192,       0 },
+	[HSC100MD][HSC_FUNCTION_B] = { 0,   1356300,  -8192,       0 },
+	[HSC100MD][HSC_FUNCTION_C] = { 0,   1525902,  -7372, -500000 },
+	[HSC100MD][HSC_FUNCTION_F] = { 0,   1356300,  -8028,       0 },
+	[HSC160MD][HSC_FUNCTION_A] = { 0,   2441257,  -8192,       0 },
+	[HSC160MD][HSC_FUNCTION_B] = { 0,   2170080,  -8192,       0 },
+	[HSC160MD][HSC_FUNCTION_C] = { 0,   2441443,  -7372, -500000 },
+	[HSC160MD][HSC_FUNCTION_F] = { 0,   2170080,  -8028,       0 },
+	[HSC250MD][HSC_FUNCTION_A] = { 0,   3814464,  -8192,       0 },
+	[HSC250MD][HSC_FUNCTION_B] = { 0,   3390750,  -8192,       0 },
+	[HSC250MD][HSC_FUNCTION_C] = { 0,   3814755,  -7372, -500000 },
+	[HSC250MD][HSC_FUNCTION_F] = { 0,   3390750,  -8028,       0 },
+	[HSC400MD][HSC_FUNCTION_A] = { 0,   6103143,  -8192,       0 },
+	[HSC400MD][HSC_FUNCTION_B] = { 0,   5425200,  -8192,       0 },
+	[HSC400MD][HSC_FUNCTION_C] = { 0,   6103608,  -7372, -500000 },
+	[HSC400MD][HSC_FUNCTION_F] = { 0,   5425200,  -8028,       0 },
+	[HSC600MD][HSC_FUNCTION_A] = { 0,   9154714,  -8192,       0 },
+	[HSC600MD][HSC_FUNCTION_B] = { 0,   8137800,  -8192,       0 },
+	[HSC600MD][HSC_FUNCTION_C] = { 0,   9155413,  -7372, -500000 },
+	[HSC600MD][HSC_FUNCTION_F] = { 0,   8137800,  -8028,       0 },
+	[HSC001BD][HSC_FUNCTION_A] = { 0,  15257857,  -8192,       0 },
+	[HSC001BD][HSC_FUNCTION_B] = { 0,  13563000,  -8192,       0 },
+	[HSC001BD][HSC_FUNCTION_C] = { 0,  15259021,  -7372, -500000 },
+	[HSC001BD][HSC_FUNCTION_F] = { 0,  13563000,  -8028,       0 },
+	[HSC1_6BD][HSC_FUNCTION_A] = { 0,  24412572,  -8192,       0 },
+	[HSC1_6BD][HSC_FUNCTION_B] = { 0,  21700800,  -8192,       0 },
+	[HSC1_6BD][HSC_FUNCTION_C] = { 0,  24414435,  -7372, -500000 },
+	[HSC1_6BD][HSC_FUNCTION_F] = { 0,  21700800,  -8028,       0 },
+	[HSC2_5BD][HSC_FUNCTION_A] = { 0,  38144644,  -8192,       0 },
+	[HSC2_5BD][HSC_FUNCTION_B] = { 0,  33907500,  -8192,       0 },
+	[HSC2_5BD][HSC_FUNCTION_C] = { 0,  38147554,  -7372, -500000 },
+	[HSC2_5BD][HSC_FUNCTION_F] = { 0,  33907500,  -8028,       0 },
+	[HSC004BD][HSC_FUNCTION_A] = { 0,  61031431,  -8192,       0 },
+	[HSC004BD][HSC_FUNCTION_B] = { 0,  54252000,  -8192,       0 },
+	[HSC004BD][HSC_FUNCTION_C] = { 0,  61036087,  -7372, -500000 },
+	[HSC004BD][HSC_FUNCTION_F] = { 0,  54252000,  -8028,       0 },
+	[HSC2_5MG][HSC_FUNCTION_A] = { 0,     19072,  -1638,       0 },
+	[HSC2_5MG][HSC_FUNCTION_B] = { 0,     16953,   -819,       0 },
+	[HSC2_5MG][HSC_FUNCTION_C] = { 0,     19073,   -819,       0 },
+	[HSC2_5MG][HSC_FUNCTION_F] = { 0,     16953,   -655,       0 },
+	[HSC004MG][HSC_FUNCTION_A] = { 0,     30515,  -1638,       0 },
+	[HSC004MG][HSC_FUNCTION_B] = { 0,     27126,   -819,       0 },
+	[HSC004MG][HSC_FUNCTION_C] = { 0,     30518,   -819,       0 },
+	[HSC004MG][HSC_FUNCTION_F] = { 0,     27126,   -655,       0 },
+	[HSC006MG][HSC_FUNCTION_A] = { 0,     45773,  -1638,       0 },
+	[HSC006MG][HSC_FUNCTION_B] = { 0,     40689,   -819,       0 },
+	[HSC006MG][HSC_FUNCTION_C] = { 0,     45777,   -819,       0 },
+	[HSC006MG][HSC_FUNCTION_F] = { 0,     40689,   -655,       0 },
+	[HSC010MG][HSC_FUNCTION_A] = { 0,     76289,  -1638,       0 },
+	[HSC010MG][HSC_FUNCTION_B] = { 0,     67815,   -819,       0 },
+	[HSC010MG][HSC_FUNCTION_C] = { 0,     76295,   -819,       0 },
+	[HSC010MG][HSC_FUNCTION_F] = { 0,     67815,   -655,       0 },
+	[HSC016MG][HSC_FUNCTION_A] = { 0,    122062,  -1638,       0 },
+	[HSC016MG][HSC_FUNCTION_B] = { 0,    108504,   -819,       0 },
+	[HSC016MG][HSC_FUNCTION_C] = { 0,    122072,   -819,       0 },
+	[HSC016MG][HSC_FUNCTION_F] = { 0,    108504,   -655,       0 },
+	[HSC025MG][HSC_FUNCTION_A] = { 0,    190723,  -1638,       0 },
+	[HSC025MG][HSC_FUNCTION_B] = { 0,    169537,   -819,       0 },
+	[HSC025MG][HSC_FUNCTION_C] = { 0,    190737,   -819,       0 },
+	[HSC025MG][HSC_FUNCTION_F] = { 0,    169537,   -655,       0 },
+	[HSC040MG][HSC_FUNCTION_A] = { 0,    305157,  -1638,       0 },
+	[HSC040MG][HSC_FUNCTION_B] = { 0,    271260,   -819,       0 },
+	[HSC040MG][HSC_FUNCTION_C] = { 0,    305180,   -819,       0 },
+	[HSC040MG][HSC_FUNCTION_F] = { 0,    271260,   -655,       0 },
+	[HSC060MG][HSC_FUNCTION_A] = { 0,    457735,  -1638,       0 },
+	[HSC060MG][HSC_FUNCTION_B] = { 0,    406890,   -819,       0 },
+	[HSC060MG][HSC_FUNCTION_C] = { 0,    457770,   -819,       0 },
+	[HSC060MG][HSC_FUNCTION_F] = { 0,    406890,   -655,       0 },
+	[HSC100MG][HSC_FUNCTION_A] = { 0,    762892,  -1638,       0 },
+	[HSC100MG][HSC_FUNCTION_B] = { 0,    678150,   -819,       0 },
+	[HSC100MG][HSC_FUNCTION_C] = { 0,    762951,   -819,       0 },
+	[HSC100MG][HSC_FUNCTION_F] = { 0,    678150,   -655,       0 },
+	[HSC160MG][HSC_FUNCTION_A] = { 0,   1220628,  -1638,       0 },
+	[HSC160MG][HSC_FUNCTION_B] = { 0,   1085040,   -819,       0 },
+	[HSC160MG][HSC_FUNCTION_C] = { 0,   1220721,   -819,       0 },
+	[HSC160MG][HSC_FUNCTION_F] = { 0,   1085040,   -655,       0 },
+	[HSC250MG][HSC_FUNCTION_A] = { 0,   1907232,  -1638,       0 },
+	[HSC250MG][HSC_FUNCTION_B] = { 0,   1695375,   -819,       0 },
+	[HSC250MG][HSC_FUNCTION_C] = { 0,   1907377,   -819,       0 },
+	[HSC250MG][HSC_FUNCTION_F] = { 0,   1695375,   -655,       0 },
+	[HSC400MG][HSC_FUNCTION_A] = { 0,   3051571,  -1638,       0 },
+	[HSC400MG][HSC_FUNCTION_B] = { 0,   2712600,   -819,       0 },
+	[HSC400MG][HSC_FUNCTION_C] = { 0,   3051804,   -819,       0 },
+	[HSC400MG][HSC_FUNCTION_F] = { 0,   2712600,   -655,       0 },
+	[HSC600MG][HSC_FUNCTION_A] = { 0,   4577357,  -1638,       0 },
+	[HSC600MG][HSC_FUNCTION_B] = { 0,   4068900,   -819,       0 },
+	[HSC600MG][HSC_FUNCTION_C] = { 0,   4577706,   -819,       0 },
+	[HSC600MG][HSC_FUNCTION_F] = { 0,   4068900,   -655,       0 },
+	[HSC001BG][HSC_FUNCTION_A] = { 0,   7628928,  -1638,       0 },
+	[HSC001BG][HSC_FUNCTION_B] = { 0,   6781500,   -819,       0 },
+	[HSC001BG][HSC_FUNCTION_C] = { 0,   7629510,   -819,       0 },
+	[HSC001BG][HSC_FUNCTION_F] = { 0,   6781500,   -655,       0 },
+	[HSC1_6BG][HSC_FUNCTION_A] = { 0,  12206286,  -1638,       0 },
+	[HSC1_6BG][HSC_FUNCTION_B] = { 0,  10850400,   -819,       0 },
+	[HSC1_6BG][HSC_FUNCTION_C] = { 0,  12207217,   -819,       0 },
+	[HSC1_6BG][HSC_FUNCTION_F] = { 0,  10850400,   -655,       0 },
+	[HSC2_5BG][HSC_FUNCTION_A] = { 0,  19072322,  -1638,       0 },
+	[HSC2_5BG][HSC_FUNCTION_B] = { 0,  16953750,   -819,       0 },
+	[HSC2_5BG][HSC_FUNCTION_C] = { 0,  19073777,   -819,       0 },
+	[HSC2_5BG][HSC_FUNCTION_F] = { 0,  16953750,   -655,       0 },
+	[HSC004BG][HSC_FUNCTION_A] = { 0,  30515715,  -1638,       0 },
+	[HSC004BG][HSC_FUNCTION_B] = { 0,  27126000,   -819,       0 },
+	[HSC004BG][HSC_FUNCTION_C] = { 0,  30518043,   -819,       0 },
+	[HSC004BG][HSC_FUNCTION_F] = { 0,  27126000,   -655,       0 },
+	[HSC006BG][HSC_FUNCTION_A] = { 0,  45773573,  -1638,       0 },
+	[HSC006BG][HSC_FUNCTION_B] = { 0,  40689000,   -819,       0 },
+	[HSC006BG][HSC_FUNCTION_C] = { 0,  45777065,   -819,       0 },
+	[HSC006BG][HSC_FUNCTION_F] = { 0,  40689000,   -655,       0 },
+	[HSC010BG][HSC_FUNCTION_A] = { 0,  76289288,  -1638,       0 },
+	[HSC010BG][HSC_FUNCTION_B] = { 0,  67815000,   -819,       0 },
+	[HSC010BG][HSC_FUNCTION_C] = { 0,  76295109,   -819,       0 },
+	[HSC010BG][HSC_FUNCTION_F] = { 0,  67815000,   -655,       0 },
+	[HSC100KA][HSC_FUNCTION_A] = { 0,   7628928,  -1638,       0 },
+	[HSC100KA][HSC_FUNCTION_B] = { 0,   6781500,   -819,       0 },
+	[HSC100KA][HSC_FUNCTION_C] = { 0,   7629510,   -819,       0 },
+	[HSC100KA][HSC_FUNCTION_F] = { 0,   6781500,   -655,       0 },
+	[HSC160KA][HSC_FUNCTION_A] = { 0,  12206286,  -1638,       0 },
+	[HSC160KA][HSC_FUNCTION_B] = { 0,  10850400,   -819,       0 },
+	[HSC160KA][HSC_FUNCTION_C] = { 0,  12207217,   -819,       0 },
+	[HSC160KA][HSC_FUNCTION_F] = { 0,  10850400,   -655,       0 },
+	[HSC250KA][HSC_FUNCTION_A] = { 0,  19072322,  -1638,       0 },
+	[HSC250KA][HSC_FUNCTION_B] = { 0,  16953750,   -819,       0 },
+	[HSC250KA][HSC_FUNCTION_C] = { 0,  19073777,   -819,       0 },
+	[HSC250KA][HSC_FUNCTION_F] = { 0,  16953750,   -655,       0 },
+	[HSC400KA][HSC_FUNCTION_A] = { 0,  30515715,  -1638,       0 },
+	[HSC400KA][HSC_FUNCTION_B] = { 0,  27126000,   -819,       0 },
+	[HSC400KA][HSC_FUNCTION_C] = { 0,  30518043,   -819,       0 },
+	[HSC400KA][HSC_FUNCTION_F] = { 0,  27126000,   -655,       0 },
+	[HSC600KA][HSC_FUNCTION_A] = { 0,  45773573,  -1638,       0 },
+	[HSC600KA][HSC_FUNCTION_B] = { 0,  40689000,   -819,       0 },
+	[HSC600KA][HSC_FUNCTION_C] = { 0,  45777065,   -819,       0 },
+	[HSC600KA][HSC_FUNCTION_F] = { 0,  40689000,   -655,       0 },
+	[HSC001GA][HSC_FUNCTION_A] = { 0,  76289288,  -1638,       0 },
+	[HSC001GA][HSC_FUNCTION_B] = { 0,  67815000,   -819,       0 },
+	[HSC001GA][HSC_FUNCTION_C] = { 0,  76295109,   -819,       0 },
+	[HSC001GA][HSC_FUNCTION_F] = { 0,  67815000,   -655,       0 },
+	[HSC160LD][HSC_FUNCTION_A] = { 0,     24412,  -8192,       0 },
+	[HSC160LD][HSC_FUNCTION_B] = { 0,     21700,  -8192,       0 },
+	[HSC160LD][HSC_FUNCTION_C] = { 0,     24414,  -7372, -500000 },
+	[HSC160LD][HSC_FUNCTION_F] = { 0,     21700,  -8028,       0 },
+	[HSC250LD][HSC_FUNCTION_A] = { 0,     38144,  -8192,       0 },
+	[HSC250LD][HSC_FUNCTION_B] = { 0,     33907,  -8192,       0 },
+	[HSC250LD][HSC_FUNCTION_C] = { 0,     38147,  -7372, -500000 },
+	[HSC250LD][HSC_FUNCTION_F] = { 0,     33907,  -8028,       0 },
+	[HSC400LD][HSC_FUNCTION_A] = { 0,     61031,  -8192,       0 },
+	[HSC400LD][HSC_FUNCTION_B] = { 0,     54252,  -8192,       0 },
+	[HSC400LD][HSC_FUNCTION_C] = { 0,     61036,  -7372, -500000 },
+	[HSC400LD][HSC_FUNCTION_F] = { 0,     54252,  -8028,       0 },
+	[HSC600LD][HSC_FUNCTION_A] = { 0,     91547,  -8192,       0 },
+	[HSC600LD][HSC_FUNCTION_B] = { 0,     81378,  -8192,       0 },
+	[HSC600LD][HSC_FUNCTION_C] = { 0,     91554,  -7372, -500000 },
+	[HSC600LD][HSC_FUNCTION_F] = { 0,     81378,  -8028,       0 },
+	[HSC001KD][HSC_FUNCTION_A] = { 0,    152578,  -8192,       0 },
+	[HSC001KD][HSC_FUNCTION_B] = { 0,    135630,  -8192,       0 },
+	[HSC001KD][HSC_FUNCTION_C] = { 0,    152590,  -7372, -500000 },
+	[HSC001KD][HSC_FUNCTION_F] = { 0,    135630,  -8028,       0 },
+	[HSC1_6KD][HSC_FUNCTION_A] = { 0,    244125,  -8192,       0 },
+	[HSC1_6KD][HSC_FUNCTION_B] = { 0,    217008,  -8192,       0 },
+	[HSC1_6KD][HSC_FUNCTION_C] = { 0,    244144,  -7372, -500000 },
+	[HSC1_6KD][HSC_FUNCTION_F] = { 0,    217008,  -8028,       0 },
+	[HSC2_5KD][HSC_FUNCTION_A] = { 0,    381446,  -8192,       0 },
+	[HSC2_5KD][HSC_FUNCTION_B] = { 0,    339075,  -8192,       0 },
+	[HSC2_5KD][HSC_FUNCTION_C] = { 0,    381475,  -7372, -500000 },
+	[HSC2_5KD][HSC_FUNCTION_F] = { 0,    339075,  -8028,       0 },
+	[HSC004KD][HSC_FUNCTION_A] = { 0,    610314,  -8192,       0 },
+	[HSC004KD][HSC_FUNCTION_B] = { 0,    542520,  -8192,       0 },
+	[HSC004KD][HSC_FUNCTION_C] = { 0,    610360,  -7372, -500000 },
+	[HSC004KD][HSC_FUNCTION_F] = { 0,    542520,  -8028,       0 },
+	[HSC006KD][HSC_FUNCTION_A] = { 0,    915471,  -8192,       0 },
+	[HSC006KD][HSC_FUNCTION_B] = { 0,    813780,  -8192,       0 },
+	[HSC006KD][HSC_FUNCTION_C] = { 0,    915541,  -7372, -500000 },
+	[HSC006KD][HSC_FUNCTION_F] = { 0,    813780,  -8028,       0 },
+	[HSC010KD][HSC_FUNCTION_A] = { 0,   1525785,  -8192,       0 },
+	[HSC010KD][HSC_FUNCTION_B] = { 0,   1356300,  -8192,       0 },
+	[HSC010KD][HSC_FUNCTION_C] = { 0,   1525902,  -7372, -500000 },
+	[HSC010KD][HSC_FUNCTION_F] = { 0,   1356300,  -8028,       0 },
+	[HSC016KD][HSC_FUNCTION_A] = { 0,   2441257,  -8192,       0 },
+	[HSC016KD][HSC_FUNCTION_B] = { 0,   2170080,  -8192,       0 },
+	[HSC016KD][HSC_FUNCTION_C] = { 0,   2441443,  -7372, -500000 },
+	[HSC016KD][HSC_FUNCTION_F] = { 0,   2170080,  -8028,       0 },
+	[HSC025KD][HSC_FUNCTION_A] = { 0,   3814464,  -8192,       0 },
+	[HSC025KD][HSC_FUNCTION_B] = { 0,   3390750,  -8192,       0 },
+	[HSC025KD][HSC_FUNCTION_C] = { 0,   3814755,  -7372, -500000 },
+	[HSC025KD][HSC_FUNCTION_F] = { 0,   3390750,  -8028,       0 },
+	[HSC040KD][HSC_FUNCTION_A] = { 0,   6103143,  -8192,       0 },
+	[HSC040KD][HSC_FUNCTION_B] = { 0,   5425200,  -8192,       0 },
+	[HSC040KD][HSC_FUNCTION_C] = { 0,   6103608,  -7372, -500000 },
+	[HSC040KD][HSC_FUNCTION_F] = { 0,   5425200,  -8028,       0 },
+	[HSC060KD][HSC_FUNCTION_A] = { 0,   9154714,  -8192,       0 },
+	[HSC060KD][HSC_FUNCTION_B] = { 0,   8137800,  -8192,       0 },
+	[HSC060KD][HSC_FUNCTION_C] = { 0,   9155413,  -7372, -500000 },
+	[HSC060KD][HSC_FUNCTION_F] = { 0,   8137800,  -8028,       0 },
+	[HSC100KD][HSC_FUNCTION_A] = { 0,  15257857,  -8192,       0 },
+	[HSC100KD][HSC_FUNCTION_B] = { 0,  13563000,  -8192,       0 },
+	[HSC100KD][HSC_FUNCTION_C] = { 0,  15259021,  -7372, -500000 },
+	[HSC100KD][HSC_FUNCTION_F] = { 0,  13563000,  -8028,       0 },
+	[HSC160KD][HSC_FUNCTION_A] = { 0,  24412572,  -8192,       0 },
+	[HSC160KD][HSC_FUNCTION_B] = { 0,  21700800,  -8192,       0 },
+	[HSC160KD][HSC_FUNCTION_C] = { 0,  24414435,  -7372, -500000 },
+	[HSC160KD][HSC_FUNCTION_F] = { 0,  21700800,  -8028,       0 },
+	[HSC250KD][HSC_FUNCTION_A] = { 0,  38144644,  -8192,       0 },
+	[HSC250KD][HSC_FUNCTION_B] = { 0,  33907500,  -8192,       0 },
+	[HSC250KD][HSC_FUNCTION_C] = { 0,  38147554,  -7372, -500000 },
+	[HSC250KD][HSC_FUNCTION_F] = { 0,  33907500,  -8028,       0 },
+	[HSC400KD][HSC_FUNCTION_A] = { 0,  61031431,  -8192,       0 },
+	[HSC400KD][HSC_FUNCTION_B] = { 0,  54252000,  -8192,       0 },
+	[HSC400KD][HSC_FUNCTION_C] = { 0,  61036087,  -7372, -500000 },
+	[HSC400KD][HSC_FUNCTION_F] = { 0,  54252000,  -8028,       0 },
+	[HSC250LG][HSC_FUNCTION_A] = { 0,     19072,  -1638,       0 },
+	[HSC250LG][HSC_FUNCTION_B] = { 0,     16953,   -819,       0 },
+	[HSC250LG][HSC_FUNCTION_C] = { 0,     19073,   -819,       0 },
+	[HSC250LG][HSC_FUNCTION_F] = { 0,     16953,   -655,       0 },
+	[HSC400LG][HSC_FUNCTION_A] = { 0,     30515,  -1638,       0 },
+	[HSC400LG][HSC_FUNCTION_B] = { 0,     27126,   -819,       0 },
+	[HSC400LG][HSC_FUNCTION_C] = { 0,     30518,   -819,       0 },
+	[HSC400LG][HSC_FUNCTION_F] = { 0,     27126,   -655,       0 },
+	[HSC600LG][HSC_FUNCTION_A] = { 0,     45773,  -1638,       0 },
+	[HSC600LG][HSC_FUNCTION_B] = { 0,     40689,   -819,       0 },
+	[HSC600LG][HSC_FUNCTION_C] = { 0,     45777,   -819,       0 },
+	[HSC600LG][HSC_FUNCTION_F] = { 0,     40689,   -655,       0 },
+	[HSC001KG][HSC_FUNCTION_A] = { 0,     76289,  -1638,       0 },
+	[HSC001KG][HSC_FUNCTION_B] = { 0,     67815,   -819,       0 },
+	[HSC001KG][HSC_FUNCTION_C] = { 0,     76295,   -819,       0 },
+	[HSC001KG][HSC_FUNCTION_F] = { 0,     67815,   -655,       0 },
+	[HSC1_6KG][HSC_FUNCTION_A] = { 0,    122062,  -1638,       0 },
+	[HSC1_6KG][HSC_FUNCTION_B] = { 0,    108504,   -819,       0 },
+	[HSC1_6KG][HSC_FUNCTION_C] = { 0,    122072,   -819,       0 },
+	[HSC1_6KG][HSC_FUNCTION_F] = { 0,    108504,   -655,       0 },
+	[HSC2_5KG][HSC_FUNCTION_A] = { 0,    190723,  -1638,       0 },
+	[HSC2_5KG][HSC_FUNCTION_B] = { 0,    169537,   -819,       0 },
+	[HSC2_5KG][HSC_FUNCTION_C] = { 0,    190737,   -819,       0 },
+	[HSC2_5KG][HSC_FUNCTION_F] = { 0,    169537,   -655,       0 },
+	[HSC004KG][HSC_FUNCTION_A] = { 0,    305157,  -1638,       0 },
+	[HSC004KG][HSC_FUNCTION_B] = { 0,    271260,   -819,       0 },
+	[HSC004KG][HSC_FUNCTION_C] = { 0,    305180,   -819,       0 },
+	[HSC004KG][HSC_FUNCTION_F] = { 0,    271260,   -655,       0 },
+	[HSC006KG][HSC_FUNCTION_A] = { 0,    457735,  -1638,       0 },
+	[HSC006KG][HSC_FUNCTION_B] = { 0,    406890,   -819,       0 },
+	[HSC006KG][HSC_FUNCTION_C] = { 0,    457770,   -819,       0 },
+	[HSC006KG][HSC_FUNCTION_F] = { 0,    406890,   -655,       0 },
+	[HSC010KG][HSC_FUNCTION_A] = { 0,    762892,  -1638,       0 },
+	[HSC010KG][HSC_FUNCTION_B] = { 0,    678150,   -819,       0 },
+	[HSC010KG][HSC_FUNCTION_C] = { 0,    762951,   -819,       0 },
+	[HSC010KG][HSC_FUNCTION_F] = { 0,    678150,   -655,       0 },
+	[HSC016KG][HSC_FUNCTION_A] = { 0,   1220628,  -1638,       0 },
+	[HSC016KG][HSC_FUNCTION_B] = { 0,   1085040,   -819,       0 },
+	[HSC016KG][HSC_FUNCTION_C] = { 0,   1220721,   -819,       0 },
+	[HSC016KG][HSC_FUNCTION_F] = { 0,   1085040,   -655,       0 },
+	[HSC025KG][HSC_FUNCTION_A] = { 0,   1907232,  -1638,       0 },
+	[HSC025KG][HSC_FUNCTION_B] = { 0,   1695375,   -819,       0 },
+	[HSC025KG][HSC_FUNCTION_C] = { 0,   1907377,   -819,       0 },
+	[HSC025KG][HSC_FUNCTION_F] = { 0,   1695375,   -655,       0 },
+	[HSC040KG][HSC_FUNCTION_A] = { 0,   3051571,  -1638,       0 },
+	[HSC040KG][HSC_FUNCTION_B] = { 0,   2712600,   -819,       0 },
+	[HSC040KG][HSC_FUNCTION_C] = { 0,   3051804,   -819,       0 },
+	[HSC040KG][HSC_FUNCTION_F] = { 0,   2712600,   -655,       0 },
+	[HSC060KG][HSC_FUNCTION_A] = { 0,   4577357,  -1638,       0 },
+	[HSC060KG][HSC_FUNCTION_B] = { 0,   4068900,   -819,       0 },
+	[HSC060KG][HSC_FUNCTION_C] = { 0,   4577706,   -819,       0 },
+	[HSC060KG][HSC_FUNCTION_F] = { 0,   4068900,   -655,       0 },
+	[HSC100KG][HSC_FUNCTION_A] = { 0,   7628928,  -1638,       0 },
+	[HSC100KG][HSC_FUNCTION_B] = { 0,   6781500,   -819,       0 },
+	[HSC100KG][HSC_FUNCTION_C] = { 0,   7629510,   -819,       0 },
+	[HSC100KG][HSC_FUNCTION_F] = { 0,   6781500,   -655,       0 },
+	[HSC160KG][HSC_FUNCTION_A] = { 0,  12206286,  -1638,       0 },
+	[HSC160KG][HSC_FUNCTION_B] = { 0,  10850400,   -819,       0 },
+	[HSC160KG][HSC_FUNCTION_C] = { 0,  12207217,   -819,       0 },
+	[HSC160KG][HSC_FUNCTION_F] = { 0,  10850400,   -655,       0 },
+	[HSC250KG][HSC_FUNCTION_A] = { 0,  19072322,  -1638,       0 },
+	[HSC250KG][HSC_FUNCTION_B] = { 0,  16953750,   -819,       0 },
+	[HSC250KG][HSC_FUNCTION_C] = { 0,  19073777,   -819,       0 },
+	[HSC250KG][HSC_FUNCTION_F] = { 0,  16953750,   -655,       0 },
+	[HSC400KG][HSC_FUNCTION_A] = { 0,  30515715,  -1638,       0 },
+	[HSC400KG][HSC_FUNCTION_B] = { 0,  27126000,   -819,       0 },
+	[HSC400KG][HSC_FUNCTION_C] = { 0,  30518043,   -819,       0 },
+	[HSC400KG][HSC_FUNCTION_F] = { 0,  27126000,   -655,       0 },
+	[HSC600KG][HSC_FUNCTION_A] = { 0,  45773573,  -1638,       0 },
+	[HSC600KG][HSC_FUNCTION_B] = { 0,  40689000,   -819,       0 },
+	[HSC600KG][HSC_FUNCTION_C] = { 0,  45777065,   -819,       0 },
+	[HSC600KG][HSC_FUNCTION_F] = { 0,  40689000,   -655,       0 },
+	[HSC001GG][HSC_FUNCTION_A] = { 0,  76289288,  -1638,       0 },
+	[HSC001GG][HSC_FUNCTION_B] = { 0,  67815000,   -819,       0 },
+	[HSC001GG][HSC_FUNCTION_C] = { 0,  76295109,   -819,       0 },
+	[HSC001GG][HSC_FUNCTION_F] = { 0,  67815000,   -655,       0 },
+	[HSC015PA][HSC_FUNCTION_A] = { 0,   7889914,  -1638,       0 },
+	[HSC015PA][HSC_FUNCTION_B] = { 0,   7013495,   -819,       0 },
+	[HSC015PA][HSC_FUNCTION_C] = { 0,   7890516,   -819,       0 },
+	[HSC015PA][HSC_FUNCTION_F] = { 0,   7013495,   -655,       0 },
+	[HSC030PA][HSC_FUNCTION_A] = { 0,  15779905,  -1638,       0 },
+	[HSC030PA][HSC_FUNCTION_B] = { 0,  14027058,   -819,       0 },
+	[HSC030PA][HSC_FUNCTION_C] = { 0,  15781109,   -819,       0 },
+	[HSC030PA][HSC_FUNCTION_F] = { 0,  14027058,   -655,       0 },
+	[HSC060PA][HSC_FUNCTION_A] = { 0,  31559734,  -1638,       0 },
+	[HSC060PA][HSC_FUNCTION_B] = { 0,  28054048,   -819,       0 },
+	[HSC060PA][HSC_FUNCTION_C] = { 0,  31562142,   -819,       0 },
+	[HSC060PA][HSC_FUNCTION_F] = { 0,  28054048,   -655,       0 },
+	[HSC100PA][HSC_FUNCTION_A] = { 0,  52599633,  -1638,       0 },
+	[HSC100PA][HSC_FUNCTION_B] = { 0,  46756815,   -819,       0 },
+	[HSC100PA][HSC_FUNCTION_C] = { 0,  52603646,   -819,       0 },
+	[HSC100PA][HSC_FUNCTION_F] = { 0,  46756815,   -655,       0 },
+	[HSC150PA][HSC_FUNCTION_A] = { 0,  78899450,  -1638,       0 },
+	[HSC150PA][HSC_FUNCTION_B] = { 0,  70135223,   -819,       0 },
+	[HSC150PA][HSC_FUNCTION_C] = { 0,  78905470,   -819,       0 },
+	[HSC150PA][HSC_FUNCTION_F] = { 0,  70135223,   -655,       0 },
+	[HSC0_5ND][HSC_FUNCTION_A] = { 0,     19072,  -8192,       0 },
+	[HSC0_5ND][HSC_FUNCTION_B] = { 0,     16953,  -8192,       0 },
+	[HSC0_5ND][HSC_FUNCTION_C] = { 0,     19073,  -7372, -500000 },
+	[HSC0_5ND][HSC_FUNCTION_F] = { 0,     16953,  -8028,       0 },
+	[HSC001ND][HSC_FUNCTION_A] = { 0,     37992,  -8192,       0 },
+	[HSC001ND][HSC_FUNCTION_B] = { 0,     33771,  -8192,       0 },
+	[HSC001ND][HSC_FUNCTION_C] = { 0,     37994,  -7372, -500000 },
+	[HSC001ND][HSC_FUNCTION_F] = { 0,     33771,  -8028,       0 },
+	[HSC002ND][HSC_FUNCTION_A] = { 0,     75984,  -8192,       0 },
+	[HSC002ND][HSC_FUNCTION_B] = { 0,     67543,  -8192,       0 },
+	[HSC002ND][HSC_FUNCTION_C] = { 0,     75989,  -7372, -500000 },
+	[HSC002ND][HSC_FUNCTION_F] = { 0,     67543,  -8028,       0 },
+	[HSC004ND][HSC_FUNCTION_A] = { 0,    151968,  -8192,       0 },
+	[HSC004ND][HSC_FUNCTION_B] = { 0,    135087,  -8192,       0 },
+	[HSC004ND][HSC_FUNCTION_C] = { 0,    151979,  -7372, -500000 },
+	[HSC004ND][HSC_FUNCTION_F] = { 0,    135087,  -8028,       0 },
+	[HSC005ND][HSC_FUNCTION_A] = { 0,    189960,  -8192,       0 },
+	[HSC005ND][HSC_FUNCTION_B] = { 0,    168859,  -8192,       0 },
+	[HSC005ND][HSC_FUNCTION_C] = { 0,    189974,  -7372, -500000 },
+	[HSC005ND][HSC_FUNCTION_F] = { 0,    168859,  -8028,       0 },
+	[HSC010ND][HSC_FUNCTION_A] = { 0,    380073,  -8192,       0 },
+	[HSC010ND][HSC_FUNCTION_B] = { 0,    337854,  -8192,       0 },
+	[HSC010ND][HSC_FUNCTION_C] = { 0,    380102,  -7372, -500000 },
+	[HSC010ND][HSC_FUNCTION_F] = { 0,    337854,  -8028,       0 },
+	[HSC020ND][HSC_FUNCTION_A] = { 0,    760146,  -8192,       0 },
+	[HSC020ND][HSC_FUNCTION_B] = { 0,    675708,  -8192,       0 },
+	[HSC020ND][HSC_FUNCTION_C] = { 0,    760204,  -7372, -500000 },
+	[HSC020ND][HSC_FUNCTION_F] = { 0,    675708,  -8028,       0 },
+	[HSC030ND][HSC_FUNCTION_A] = { 0,   1140219,  -8192,       0 },
+	[HSC030ND][HSC_FUNCTION_B] = { 0,   1013563,  -8192,       0 },
+	[HSC030ND][HSC_FUNCTION_C] = { 0,   1140306,  -7372, -500000 },
+	[HSC030ND][HSC_FUNCTION_F] = { 0,   1013563,  -8028,       0 },
+	[HSC001PD][HSC_FUNCTION_A] = { 0,   1052029,  -8192,       0 },
+	[HSC001PD][HSC_FUNCTION_B] = { 0,    935168,  -8192,       0 },
+	[HSC001PD][HSC_FUNCTION_C] = { 0,   1052109,  -7372, -500000 },
+	[HSC001PD][HSC_FUNCTION_F] = { 0,    935168,  -8028,       0 },
+	[HSC005PD][HSC_FUNCTION_A] = { 0,   5259993,  -8192,       0 },
+	[HSC005PD][HSC_FUNCTION_B] = { 0,   4675708,  -8192,       0 },
+	[HSC005PD][HSC_FUNCTION_C] = { 0,   5260395,  -7372, -500000 },
+	[HSC005PD][HSC_FUNCTION_F] = { 0,   4675708,  -8028,       0 },
+	[HSC015PD][HSC_FUNCTION_A] = { 0,  15779829,  -8192,       0 },
+	[HSC015PD][HSC_FUNCTION_B] = { 0,  14026990,  -8192,       0 },
+	[HSC015PD][HSC_FUNCTION_C] = { 0,  15781033,  -7372, -500000 },
+	[HSC015PD][HSC_FUNCTION_F] = { 0,  14026990,  -8028,       0 },
+	[HSC030PD][HSC_FUNCTION_A] = { 0,  31559810,  -8192,       0 },
+	[HSC030PD][HSC_FUNCTION_B] = { 0,  28054116,  -8192,       0 },
+	[HSC030PD][HSC_FUNCTION_C] = { 0,  31562218,  -7372, -500000 },
+	[HSC030PD][HSC_FUNCTION_F] = { 0,  28054116,  -8028,       0 },
+	[HSC060PD][HSC_FUNCTION_A] = { 0,  63119469,  -8192,       0 },
+	[HSC060PD][HSC_FUNCTION_B] = { 0,  56108097,  -8192,       0 },
+	[HSC060PD][HSC_FUNCTION_C] = { 0,  63124284,  -7372, -500000 },
+	[HSC060PD][HSC_FUNCTION_F] = { 0,  56108097,  -8028,       0 },
+	[HSC001NG][HSC_FUNCTION_A] = { 0,     18996,  -1638,       0 },
+	[HSC001NG][HSC_FUNCTION_B] = { 0,     16885,   -819,       0 },
+	[HSC001NG][HSC_FUNCTION_C] = { 0,     18997,   -819,       0 },
+	[HSC001NG][HSC_FUNCTION_F] = { 0,     16885,   -655,       0 },
+	[HSC002NG][HSC_FUNCTION_A] = { 0,     37992,  -1638,       0 },
+	[HSC002NG][HSC_FUNCTION_B] = { 0,     33771,   -819,       0 },
+	[HSC002NG][HSC_FUNCTION_C] = { 0,     37994,   -819,       0 },
+	[HSC002NG][HSC_FUNCTION_F] = { 0,     33771,   -655,       0 },
+	[HSC004NG][HSC_FUNCTION_A] = { 0,     75984,  -1638,       0 },
+	[HSC004NG][HSC_FUNCTION_B] = { 0,     67543,   -819,       0 },
+	[HSC004NG][HSC_FUNCTION_C] = { 0,     75989,   -819,       0 },
+	[HSC004NG][HSC_FUNCTION_F] = { 0,     67543,   -655,       0 },
+	[HSC005NG][HSC_FUNCTION_A] = { 0,     94980,  -1638,       0 },
+	[HSC005NG][HSC_FUNCTION_B] = { 0,     84429,   -819,       0 },
+	[HSC005NG][HSC_FUNCTION_C] = { 0,     94987,   -819,       0 },
+	[HSC005NG][HSC_FUNCTION_F] = { 0,     84429,   -655,       0 },
+	[HSC010NG][HSC_FUNCTION_A] = { 0,    190036,  -1638,       0 },
+	[HSC010NG][HSC_FUNCTION_B] = { 0,    168927,   -819,       0 },
+	[HSC010NG][HSC_FUNCTION_C] = { 0,    190051,   -819,       0 },
+	[HSC010NG][HSC_FUNCTION_F] = { 0,    168927,   -655,       0 },
+	[HSC020NG][HSC_FUNCTION_A] = { 0,    380073,  -1638,       0 },
+	[HSC020NG][HSC_FUNCTION_B] = { 0,    337854,   -819,       0 },
+	[HSC020NG][HSC_FUNCTION_C] = { 0,    380102,   -819,       0 },
+	[HSC020NG][HSC_FUNCTION_F] = { 0,    337854,   -655,       0 },
+	[HSC030NG][HSC_FUNCTION_A] = { 0,    570109,  -1638,       0 },
+	[HSC030NG][HSC_FUNCTION_B] = { 0,    506781,   -819,       0 },
+	[HSC030NG][HSC_FUNCTION_C] = { 0,    570153,   -819,       0 },
+	[HSC030NG][HSC_FUNCTION_F] = { 0,    506781,   -655,       0 },
+	[HSC001PG][HSC_FUNCTION_A] = { 0,    526014,  -1638,       0 },
+	[HSC001PG][HSC_FUNCTION_B] = { 0,    467584,   -819,       0 },
+	[HSC001PG][HSC_FUNCTION_C] = { 0,    526054,   -819,       0 },
+	[HSC001PG][HSC_FUNCTION_F] = { 0,    467584,   -655,       0 },
+	[HSC005PG][HSC_FUNCTION_A] = { 0,   2629996,  -1638,       0 },
+	[HSC005PG][HSC_FUNCTION_B] = { 0,   2337854,   -819,       0 },
+	[HSC005PG][HSC_FUNCTION_C] = { 0,   2630197,   -819,       0 },
+	[HSC005PG][HSC_FUNCTION_F] = { 0,   2337854,   -655,       0 },
+	[HSC015PG][HSC_FUNCTION_A] = { 0,   7889914,  -1638,       0 },
+	[HSC015PG][HSC_FUNCTION_B] = { 0,   7013495,   -819,       0 },
+	[HSC015PG][HSC_FUNCTION_C] = { 0,   7890516,   -819,       0 },
+	[HSC015PG][HSC_FUNCTION_F] = { 0,   7013495,   -655,       0 },
+	[HSC030PG][HSC_FUNCTION_A] = { 0,  15779905,  -1638,       0 },
+	[HSC030PG][HSC_FUNCTION_B] = { 0,  14027058,   -819,       0 },
+	[HSC030PG][HSC_FUNCTION_C] = { 0,  15781109,   -819,       0 },
+	[HSC030PG][HSC_FUNCTION_F] = { 0,  14027058,   -655,       0 },
+	[HSC060PG][HSC_FUNCTION_A] = { 0,  31559734,  -1638,       0 },
+	[HSC060PG][HSC_FUNCTION_B] = { 0,  28054048,   -819,       0 },
+	[HSC060PG][HSC_FUNCTION_C] = { 0,  31562142,   -819,       0 },
+	[HSC060PG][HSC_FUNCTION_F] = { 0,  28054048,   -655,       0 },
+	[HSC100PG][HSC_FUNCTION_A] = { 0,  52599633,  -1638,       0 },
+	[HSC100PG][HSC_FUNCTION_B] = { 0,  46756815,   -819,       0 },
+	[HSC100PG][HSC_FUNCTION_C] = { 0,  52603646,   -819,       0 },
+	[HSC100PG][HSC_FUNCTION_F] = { 0,  46756815,   -655,       0 },
+	[HSC150PG][HSC_FUNCTION_A] = { 0,  78899450,  -1638,       0 },
+	[HSC150PG][HSC_FUNCTION_B] = { 0,  70135223,   -819,       0 },
+	[HSC150PG][HSC_FUNCTION_C] = { 0,  78905470,   -819,       0 },
+	[HSC150PG][HSC_FUNCTION_F] = { 0,  70135223,   -655,       0 },
+};
+
+#endif
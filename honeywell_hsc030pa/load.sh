@@ -1,5 +1,6 @@
 #!/bin/bash
 
+insmod ../iio_rt_capture/iio_rt_capture.ko
 insmod hsc030pa.ko
 insmod hsc030pa_i2c.ko
 insmod hsc030pa_spi.ko
@@ -1,70 +1,125 @@
 #!/bin/bash
 
-# chip variants based on the manufacturer datasheet
-# obtained via `pdftotext -layout`
-
-IN_FILE='ssc_variants.txt'
+# generate hsc030pa_variants.h based on the chip variants listed in the
+# manufacturer datasheets, obtained via `pdftotext -layout`
+#
+# usage: parse_variants_table.sh [-c] [OUT_FILE]
+#   -c  do not write OUT_FILE, fail if it differs from the generated content
+#
+# the HSC and SSC datasheets list the same pressure ranges, the tables are
+# generated from the first file and the others must agree with it.
+#
+# all the integer math is done by bash with the same 64bit truncating
+# division as the div_s64() calls in hsc_common_probe(), so the precomputed
+# table matches what the driver computes for a custom range.
+
+IN_FILES=('hsc_variants.txt' 'ssc_variants.txt')
+OUT_FILE='hsc030pa_variants.h'
 PREFIX='HSC'
 
-#IN_FILE='mpr_variants.txt'
-#PREFIX='MPR'
+# transfer functions, outputs are given in counts
+#  function A: 10% - 90% of 2^14
+#  function B:  5% - 95% of 2^14
+#  function C:  5% - 85% of 2^14
+#  function F:  4% - 94% of 2^14
+FUNCTIONS=('A' 'B' 'C' 'F')
+FUNC_OUTMIN=(1638 819 819 655)
+FUNC_OUTMAX=(14746 15565 13926 15401)
+
+MICRO=1000000
+NANO=1000000000
 
 PREFIX_LC=$(echo "${PREFIX}" | tr '[:upper:]' '[:lower:]')
 
-clean_d() {
-    input_d=$1
-    if [ "$(echo "${input_d}" | sed 's|[0-9]||g' | wc -c)" != '1' ]; then
-        err 'error: invalid input'
-        exit 1
-    fi
-    clean_input="${input_d}"
+err()
+{
+    echo "$@" >&2
 }
 
-conv_dh() {
-    clean_d "$1"
-    result=$(echo "ibase=10;obase=16;${clean_input}" | bc)
+# print 'name enum pmin pmax' for every variant, limits converted to pascals
+parse_variants()
+{
+    awk '
+    BEGIN {
+        mult["kPa"] = 1000; mult["MPa"] = 1000000; mult["Pa"] = 1
+        mult["mbar"] = 100; mult["bar"] = 100000
+        mult["psi"] = 6894.75729; mult["inH2O"] = 249.0889
+        mult["mmHg"] = 133.3223684
+    }
+    NF {
+        if (!($4 in mult)) {
+            print "error: unknown unit " $4 " in line " NR > "/dev/stderr"
+            exit 1
+        }
+        enum = $1
+        sub(/\./, "_", enum)
+        printf "%s %s %.0f %.0f\n", $1, enum, $2 * mult[$4], $3 * mult[$4]
+    }' "$1"
 }
 
-prettify_hex() {
-    h="${1}"
-    echo "$h" | tr '[:upper:]' '[:lower:]' | sed 's|^|0x|;s| | 0x|g' | xargs
-}
+create_func_spec()
+{
+    local i
+
+    cat << EOF
+struct ${PREFIX_LC}_func_spec {
+	u32 output_min;
+	u32 output_max;
+};
 
+/*
+ * function A: 10% - 90% of 2^14
+ * function B:  5% - 95% of 2^14
+ * function C:  5% - 85% of 2^14
+ * function F:  4% - 94% of 2^14
+ */
+static const struct ${PREFIX_LC}_func_spec ${PREFIX_LC}_func_spec[] = {
+EOF
+    for i in "${!FUNCTIONS[@]}"; do
+        printf '\t[%s_FUNCTION_%s] = { .output_min = %4d, .output_max = %5d },\n' \
+            "${PREFIX}" "${FUNCTIONS[$i]}" "${FUNC_OUTMIN[$i]}" "${FUNC_OUTMAX[$i]}"
+    done
+    echo -e '};\n'
+}
 
-create_c_file()
+create_enum()
 {
+    local i=0 name enum pmin pmax
+
     echo -n "enum ${PREFIX_LC}_variants {"
-    i=0
-    cat "${IN_FILE}" | while read -r line; do
-        if [ $((i%4)) == 0 ]; then
+    while read -r name enum pmin pmax; do
+        if [ $((i % 4)) == 0 ]; then
             echo -en "\n\t"
         else
             echo -n ' '
         fi
-        name=$(echo "${line}" | awk '{ print $1}')
-        enum=$(echo "${name}" | sed 's|\.|_|;')
-        conv_dh "${i}"
-        num=$(prettify_hex "${result}")
-        echo -n "${PREFIX}${enum} = ${num},"
-        i=$((i+1))
-    done
+        printf '%s%s = 0x%02x,' "${PREFIX}" "${enum}" "${i}"
+        i=$((i + 1))
+    done <<< "${VARIANTS}"
     echo -e " ${PREFIX}_VARIANTS_MAX"
     echo -e '};\n'
+}
+
+create_triplets()
+{
+    local i=0 name enum pmin pmax
 
     echo -n "static const char * const ${PREFIX_LC}_triplet_variants[${PREFIX}_VARIANTS_MAX] = {"
-    i=0
-    cat "${IN_FILE}" | while read -r line; do
-        if [ $((i%3)) == 0 ]; then
+    while read -r name enum pmin pmax; do
+        if [ $((i % 3)) == 0 ]; then
             echo -en "\n\t"
         else
             echo -n ' '
         fi
-        name=$(echo "${line}" | awk '{ print $1}')
-        enum=$(echo "${name}" | sed 's|\.|_|;')
-        echo -en "[${PREFIX}${enum}] = \"${name}\","
-        i=$((i+1))
-    done
+        echo -n "[${PREFIX}${enum}] = \"${name}\","
+        i=$((i + 1))
+    done <<< "${VARIANTS}"
     echo -e '\n};\n'
+}
+
+create_range_config()
+{
+    local name enum pmin pmax
 
     cat << EOF
 /**
@@ -80,51 +135,105 @@ struct ${PREFIX_LC}_range_config {
 /* All min max limits have been converted to pascals */
 static const struct ${PREFIX_LC}_range_config ${PREFIX_LC}_range_config[${PREFIX}_VARIANTS_MAX] = {
 EOF
-    cat "${IN_FILE}" | while read -r line; do
-        name=$(echo "${line}" | awk '{ print $1}')
-        enum=$(echo "${name}" | sed 's|\.|_|;')
-        #id=$(echo "${PREFIX}${name}" | sed 's|\.|_|')
-        unit=$(echo "${line}" | awk '{ print $4}')
-        mult=0
-        case "${unit}" in
-            kPa)
-                mult=1000
-                ;;
-            MPa)
-                mult=1000000
-                ;;
-            Pa)
-                mult=1
-                ;;
-            mbar)
-                mult=100
-                ;;
-            bar)
-                mult=100000
-                ;;
-            psi)
-                mult=6894.75729
-                ;;
-            inH2O)
-                mult=249.0889
-                ;;
-            mmHg)
-                mult=133.3223684
-                ;;
-        esac
-        min=$(echo "${line}" | awk '{ print $2}')
-        min=$(echo "${min}*${mult}" | bc)
-        min=$(printf "%.0f" "${min}")
-        max=$(echo "${line}" | awk '{ print $3}')
-        max=$(echo "${max}*${mult}" | bc)
-        max=$(printf "%.0f" "${max}")
-
-        #echo "${name} ${id} ${min} ${max} ${unit}"
-        echo -e "\t[${PREFIX}${enum}] = { .pmin = ${min}, .pmax = ${max} },"
-    done | column -t -R 6,9 | sed 's| \.|.|g;s| = |=|g;s| }|}|;s|^|\t|'
+    while read -r name enum pmin pmax; do
+        printf '\t[%s%s] = { .pmin = %7d, .pmax = %7d },\n' \
+            "${PREFIX}" "${enum}" "${pmin}" "${pmax}"
+    done <<< "${VARIANTS}"
+    echo -e '};\n'
+}
+
+# IIO ABI: pressure = (raw + offset) * scale, see hsc_common_probe()
+create_conv()
+{
+    local name enum pmin pmax i outmin outmax tmp
+
+    cat << EOF
+/**
+ * struct ${PREFIX_LC}_conv - pressure scale and offset, precomputed for every
+ *                   variant and transfer function
+ * @scale: pressure scale, integer part
+ * @scale_dec: pressure scale, nano units
+ * @offset: pressure offset, integer part
+ * @offset_dec: pressure offset, micro units
+ */
+struct ${PREFIX_LC}_conv {
+	s64 scale;
+	s32 scale_dec;
+	s64 offset;
+	s32 offset_dec;
+};
+
+static const struct ${PREFIX_LC}_conv ${PREFIX_LC}_conv[${PREFIX}_VARIANTS_MAX][${PREFIX}_FUNCTION_${FUNCTIONS[-1]} + 1] = {
+EOF
+    while read -r name enum pmin pmax; do
+        for i in "${!FUNCTIONS[@]}"; do
+            outmin=${FUNC_OUTMIN[$i]}
+            outmax=${FUNC_OUTMAX[$i]}
+            tmp=$(( (pmax - pmin) * MICRO / (outmax - outmin) ))
+            scale=$(( tmp / NANO ))
+            scale_dec=$(( tmp % NANO ))
+            tmp=$(( pmin * (outmax - outmin) * MICRO / (pmax - pmin) ))
+            tmp=$(( tmp - outmin * MICRO ))
+            offset=$(( tmp / MICRO ))
+            offset_dec=$(( tmp % MICRO ))
+            printf '\t[%s%s][%s_FUNCTION_%s] = { %d, %9d, %6d, %7d },\n' \
+                "${PREFIX}" "${enum}" "${PREFIX}" "${FUNCTIONS[$i]}" \
+                "${scale}" "${scale_dec}" "${offset}" "${offset_dec}"
+        done
+    done <<< "${VARIANTS}"
     echo '};'
 }
 
-create_c_file | sed 's/[ \t]*$//' > out.c
+create_h_file()
+{
+    cat << EOF
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Honeywell TruStability HSC Series pressure/temperature sensor
+ *
+ * generated by scripts/parse_variants_table.sh from ${IN_FILES[0]},
+ * do not edit
+ */
 
+#ifndef _HSC030PA_VARIANTS_H
+#define _HSC030PA_VARIANTS_H
 
+#include <linux/types.h>
+
+#include "hsc030pa.h"
+
+EOF
+    create_func_spec
+    create_enum
+    create_triplets
+    create_range_config
+    create_conv
+    echo -e '\n#endif'
+}
+
+check=0
+if [ "$1" == '-c' ]; then
+    check=1
+    shift
+fi
+[ -n "$1" ] && OUT_FILE="$1"
+
+VARIANTS=$(parse_variants "${IN_FILES[0]}") || exit 1
+
+for f in "${IN_FILES[@]:1}"; do
+    other=$(parse_variants "${f}") || exit 1
+    if [ "${other}" != "${VARIANTS}" ]; then
+        err "error: ${f} and ${IN_FILES[0]} list different pressure ranges"
+        diff <(echo "${VARIANTS}") <(echo "${other}") >&2
+        exit 1
+    fi
+done
+
+if [ "${check}" == 1 ]; then
+    if ! diff -u "${OUT_FILE}" <(create_h_file) >&2; then
+        err "error: ${OUT_FILE} is out of date, run 'make variants'"
+        exit 1
+    fi
+else
+    create_h_file > "${OUT_FILE}"
+fi
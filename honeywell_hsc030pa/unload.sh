@@ -3,4 +3,5 @@
 rmmod hsc030pa_i2c
 rmmod hsc030pa_spi
 rmmod hsc030pa
+rmmod iio_rt_capture
 
@@ -1,5 +1,6 @@
 #!/bin/bash
 
+insmod ../iio_rt_capture/iio_rt_capture.ko
 insmod mprls0025pa.ko
 insmod mprls0025pa_i2c.ko
 insmod mprls0025pa_spi.ko
@@ -11,16 +11,27 @@
 
 #include <linux/array_size.h>
 #include <linux/bitfield.h>
+#include <linux/bitmap.h>
 #include <linux/bits.h>
+#include <linux/kthread.h>
+#include <linux/log2.h>
+#include <linux/ktime.h>
+#include <linux/list.h>
 #include <linux/math64.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
 #include <linux/property.h>
+#include <linux/slab.h>
+#include <linux/string.h>
+#include <linux/sysfs.h>
 #include <linux/units.h>
+#include <linux/workqueue.h>
 
 #include <linux/gpio/consumer.h>
 
 #include <linux/iio/buffer.h>
+#include <linux/iio/sysfs.h>
+#include <linux/iio/trigger.h>
 #include <linux/iio/trigger_consumer.h>
 #include <linux/iio/triggered_buffer.h>
 
@@ -152,12 +163,36 @@ static const struct mpr_range_config mpr_range_config[MPR_VARIANTS_MAX] = {
 	[MPR0300YG] = { .pmin = 0, .pmax =  39997 }
 };
 
-static const struct iio_chan_spec mpr_channels[] = {
+/**
+ * struct mpr_group - sensors on one bus whose conversions are interleaved
+ * @node: entry in mpr_groups
+ * @bus: parent device of the members, the i2c adapter or spi controller
+ * @trig: trigger shared by the members
+ * @users: members that still reference the group
+ * @lock: serializes the acquisition rounds and the member list
+ * @members: members that are part of the next acquisition round
+ */
+struct mpr_group {
+	struct list_head node;
+	struct device *bus;
+	struct iio_trigger *trig;
+	unsigned int users;
+	struct mutex lock;
+	struct list_head members;
+};
+
+static LIST_HEAD(mpr_groups);
+static DEFINE_MUTEX(mpr_groups_lock);
+
+const struct iio_chan_spec mpr_channels[MPR_NUM_CHANNELS] = {
 	{
 		.type = IIO_PRESSURE,
 		.info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
 					BIT(IIO_CHAN_INFO_SCALE) |
-					BIT(IIO_CHAN_INFO_OFFSET),
+					BIT(IIO_CHAN_INFO_OFFSET) |
+					BIT(IIO_CHAN_INFO_OVERSAMPLING_RATIO),
+		.info_mask_separate_available =
+					BIT(IIO_CHAN_INFO_OVERSAMPLING_RATIO),
 		.scan_index = 0,
 		.scan_type = {
 			.sign = 's',
@@ -168,160 +203,1404 @@ static const struct iio_chan_spec mpr_channels[] = {
 	},
 	IIO_CHAN_SOFT_TIMESTAMP(1),
 };
+EXPORT_SYMBOL_NS(mpr_channels, IIO_HONEYWELL_MPRLS0025PA);
+
+static void mpr_reset(struct mpr_data *data)
+{
+	if (data->gpiod_reset) {
+		gpiod_set_value(data->gpiod_reset, 0);
+		udelay(10);
+		gpiod_set_value(data->gpiod_reset, 1);
+	}
+
+	/* also covers the power-up, the reset happens right after vdd enable */
+	data->ready_time = ktime_add_us(ktime_get(), MPR_STARTUP_TIME_US);
+}
+
+/*
+ * commands sent before the startup time has passed are either ignored or
+ * answered with a busy status, wait for the sensor to become ready instead
+ */
+static void mpr_wait_ready(struct mpr_data *data)
+{
+	s64 remaining = ktime_us_delta(data->ready_time, ktime_get());
+
+	if (remaining > 0)
+		fsleep(remaining);
+}
+
+/* the longest a conversion may take before it is considered failed */
+static unsigned long mpr_conv_timeout_us(struct mpr_data *data)
+{
+	return MPR_CONV_TIME_US +
+	       MPR_CONV_TIME_US / 100 * data->timeout_margin_pct;
+}
+
+static int mpr_start_conversion(struct mpr_data *data)
+{
+	int ret;
+
+	mpr_wait_ready(data);
+
+	reinit_completion(&data->completion);
+
+	ret = data->ops->write(data, MPR_CMD_SYNC, MPR_PKT_SYNC_LEN);
+	if (ret < 0) {
+		data->err_stats.bus++;
+		dev_dbg(data->dev, "error while writing ret: %d\n", ret);
+		return ret;
+	}
+
+	data->conv_start = ktime_get();
+	data->conv_pending = true;
+
+	return 0;
+}
+
+/*
+ * a single look at a running conversion, via the eoc gpio if there is one or
+ * else via the status byte. @full reads the complete result while at it.
+ * Return: 1 if the conversion is done, 0 if busy, negative error code
+ */
+static int mpr_poll_conversion(struct mpr_data *data, bool full)
+{
+	int ret;
+
+	if (data->gpiod_eoc) {
+		ret = gpiod_get_value_cansleep(data->gpiod_eoc);
+	} else {
+		ret = data->ops->read(data, MPR_CMD_NOP,
+				      full ? MPR_PKT_NOP_LEN : 1);
+		if (ret >= 0)
+			ret = !(data->buffer[0] &
+				(full ? MPR_ST_BUSY : MPR_ST_ERR_FLAG));
+	}
+
+	if (ret < 0) {
+		data->err_stats.bus++;
+		dev_dbg(data->dev, "error while polling, status: %d\n", ret);
+	}
+
+	return ret;
+}
+
+/*
+ * without the eoc irq the status byte is polled. the first poll is scheduled
+ * one poll interval before the conversion is expected to end, based on the
+ * conversion times observed so far, the following polls are MPR_POLL_US
+ * apart. a conversion that is already done at the first poll ended earlier
+ * than expected, which shortens the learned time. if the first poll happens
+ * late anyway (a pipelined conversion collected by a slow trigger) it tells
+ * nothing about the conversion time and is not learned from.
+ *
+ * in MPR_POLL_RESULT mode every poll reads the complete result, which spares
+ * the separate result read once the sensor is no longer busy. with an eoc
+ * gpio its level is polled instead of the bus, at a finer interval since a
+ * gpio read is cheap.
+ *
+ * Return: 1 if data->buffer already holds the result, 0 if it still has to
+ * be read, negative error code otherwise
+ */
+static int mpr_wait_conversion(struct mpr_data *data)
+{
+	unsigned long expected = ewma_mpr_conv_read(&data->conv_time);
+	unsigned long timeout = mpr_conv_timeout_us(data);
+	bool full = !data->gpiod_eoc && data->poll_mode == MPR_POLL_RESULT;
+	unsigned int poll_us = data->gpiod_eoc ? MPR_EOC_POLL_US : MPR_POLL_US;
+	unsigned int polls = 0;
+	s64 elapsed, remaining;
+	int ret;
+
+	remaining = (s64)expected - poll_us -
+		    ktime_us_delta(ktime_get(), data->conv_start);
+	if (remaining > 0)
+		fsleep(remaining);
+
+	for (;;) {
+		ret = mpr_poll_conversion(data, full);
+		if (ret < 0)
+			return ret;
+		polls++;
+		elapsed = ktime_us_delta(ktime_get(), data->conv_start);
+
+		if (ret)
+			break;
+
+		if (elapsed > timeout) {
+			data->conv_stats.polls += polls;
+			data->err_stats.timeouts++;
+			dev_dbg(data->dev, "timeout while reading\n");
+			return -ETIMEDOUT;
+		}
+
+		usleep_range(poll_us, poll_us + poll_us / 4);
+	}
+
+	if (polls > 1)
+		ewma_mpr_conv_add(&data->conv_time, elapsed);
+	else if (remaining > 0)
+		ewma_mpr_conv_add(&data->conv_time,
+				  max_t(s64, elapsed - poll_us, 1));
+	data->conv_stats.conversions++;
+	data->conv_stats.polls += polls;
+
+	return full;
+}
+
+/* Return: see mpr_wait_conversion() */
+static int mpr_wait_done(struct mpr_data *data)
+{
+	int ret;
+
+	data->conv_pending = false;
+
+	if (data->irq <= 0)
+		return mpr_wait_conversion(data);
+
+	ret = wait_for_completion_timeout(&data->completion,
+				usecs_to_jiffies(mpr_conv_timeout_us(data)));
+	if (!ret) {
+		data->err_stats.timeouts++;
+		dev_dbg(data->dev, "timeout while waiting for eoc irq\n");
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+static int mpr_decode_result(struct mpr_data *data, s32 *press)
+{
+	if (data->buffer[0] & MPR_ST_ERR_FLAG) {
+		data->err_stats.status++;
+		dev_dbg(data->dev,
+			"unexpected status byte %02x\n", data->buffer[0]);
+		return -ETIMEDOUT;
+	}
+
+	*press = get_unaligned_be24(&data->buffer[1]);
+
+	dev_dbg(data->dev, "received: %*ph cnt: %d\n", MPR_PKT_NOP_LEN,
+		data->buffer, *press);
+
+	return 0;
+}
+
+/* @fetched: the result was already read while polling */
+static int mpr_read_result(struct mpr_data *data, bool fetched, s32 *press)
+{
+	int ret;
+
+	if (!fetched) {
+		ret = data->ops->read(data, MPR_CMD_NOP, MPR_PKT_NOP_LEN);
+		if (ret < 0) {
+			data->err_stats.bus++;
+			return ret;
+		}
+	}
+
+	return mpr_decode_result(data, press);
+}
+
+/*
+ * read the finished conversion and start the next one. transports that can
+ * queue both commands in one submission provide read_restart, the others
+ * send them one after the other. a result that was fetched while polling
+ * only needs the measurement command.
+ */
+static int mpr_read_restart(struct mpr_data *data, bool fetched, s32 *press)
+{
+	int ret;
+
+	if (fetched || !data->ops->read_restart) {
+		ret = mpr_read_result(data, fetched, press);
+		if (ret)
+			return ret;
+
+		return mpr_start_conversion(data);
+	}
+
+	mpr_wait_ready(data);
+	reinit_completion(&data->completion);
+
+	ret = data->ops->read_restart(data);
+	if (ret < 0) {
+		data->err_stats.bus++;
+		return ret;
+	}
+
+	data->conv_start = ktime_get();
+	data->conv_pending = true;
+
+	return mpr_decode_result(data, press);
+}
+
+/**
+ * mpr_read_pressure() - Read pressure value from sensor
+ * @data: Pointer to private data struct.
+ * @press: Output value read from sensor.
+ *
+ * Reading from the sensor by sending and receiving telegrams.
+ *
+ * If there is an end of conversion (EOC) interrupt registered the function
+ * waits for the interrupt, otherwise the status is polled via
+ * mpr_wait_conversion(). Either way it gives up after mpr_conv_timeout_us().
+ *
+ * Context: The function can sleep and data->lock should be held when calling it
+ * Return:
+ * * 0		- OK, the pressure value could be read
+ * * -ETIMEDOUT	- Timeout while waiting for the EOC interrupt or busy flag is
+ *		  still set after mpr_conv_timeout_us()
+ */
+static int mpr_read_pressure(struct mpr_data *data, s32 *press)
+{
+	int ret;
+
+	ret = mpr_start_conversion(data);
+	if (ret)
+		return ret;
+
+	ret = mpr_wait_done(data);
+	if (ret < 0)
+		return ret;
+
+	return mpr_read_result(data, ret, press);
+}
+
+/*
+ * a sensor that keeps failing is reset via its reset gpio after
+ * reset_threshold consecutive failed reads, and again after every further
+ * reset_threshold failures. the time from the first failure to the next good
+ * read is kept as the recovery time.
+ * Context: data->lock must be held
+ */
+static void mpr_check_health(struct mpr_data *data, int ret)
+{
+	if (ret >= 0) {
+		if (data->fail_streak) {
+			data->err_stats.recovery_us =
+				ktime_us_delta(ktime_get(), data->fail_start);
+			data->fail_streak = 0;
+		}
+		return;
+	}
+
+	if (!data->fail_streak++)
+		data->fail_start = ktime_get();
+
+	if (!data->gpiod_reset || !data->reset_threshold ||
+	    data->fail_streak % data->reset_threshold)
+		return;
+
+	dev_warn_ratelimited(data->dev, "%u consecutive failures, resetting\n",
+			     data->fail_streak);
+	mpr_reset(data);
+	data->conv_pending = false;
+	data->err_stats.resets++;
+}
+
+/*
+ * sum up 2^os_shift conversions. the 24 bit counts of up to 128 conversions
+ * fit into the s32 channel, so the sum is reported as it is and the scale
+ * and offset account for it.
+ */
+static int mpr_read_oversampled(struct mpr_data *data, s32 *press)
+{
+	unsigned int i;
+	s32 sum = 0, val;
+	int ret;
+
+	for (i = 0; i < BIT(data->os_shift); i++) {
+		ret = mpr_read_pressure(data, &val);
+		if (ret)
+			return ret;
+		sum += val;
+	}
+
+	*press = sum;
+
+	return 0;
+}
+
+/*
+ * buffered modes that get one conversion at a time sum them up here, a
+ * failed conversion drops the partial sum.
+ * Return: true once chan.pres holds the sum of 2^os_shift conversions
+ */
+static bool mpr_accumulate(struct mpr_data *data, int ret, s32 press)
+{
+	if (ret) {
+		data->os_count = 0;
+		return false;
+	}
+
+	if (!data->os_count++)
+		data->os_sum = 0;
+	data->os_sum += press;
+
+	if (data->os_count < BIT(data->os_shift))
+		return false;
+
+	data->os_count = 0;
+	data->chan.pres = data->os_sum;
+
+	return true;
+}
+
+static irqreturn_t mpr_eoc_handler(int irq, void *p)
+{
+	struct mpr_data *data = p;
+
+	if (READ_ONCE(data->drdy_enabled)) {
+		data->eoc_ts = iio_get_time_ns(data->indio_dev);
+		cancel_delayed_work(&data->drdy_watchdog);
+		iio_trigger_poll(data->trig);
+	} else {
+		complete(&data->completion);
+	}
+
+	return IRQ_HANDLED;
+}
+
+/*
+ * start the next conversion of the end of conversion trigger. the watchdog is
+ * armed even if the command failed, it retries once the conversion would
+ * have timed out.
+ * Context: data->lock must be held
+ */
+static int mpr_drdy_sync(struct mpr_data *data)
+{
+	int ret;
+
+	mpr_wait_ready(data);
+	ret = data->ops->write(data, MPR_CMD_SYNC, MPR_PKT_SYNC_LEN);
+	if (ret < 0)
+		data->err_stats.bus++;
+
+	mod_delayed_work(system_wq, &data->drdy_watchdog,
+			 usecs_to_jiffies(mpr_conv_timeout_us(data)));
+
+	return ret;
+}
+
+/*
+ * the trigger chain stops for good if a measurement command gets lost or the
+ * sensor never signals the end of its conversion. that is counted as a
+ * timeout, mpr_check_health() gets to reset a sensor that keeps failing and
+ * a new conversion is started.
+ */
+static void mpr_drdy_watchdog(struct work_struct *work)
+{
+	struct mpr_data *data = container_of(to_delayed_work(work),
+					     struct mpr_data, drdy_watchdog);
+
+	mutex_lock(&data->lock);
+	if (data->drdy_enabled) {
+		data->err_stats.timeouts++;
+		dev_dbg(data->dev, "no end of conversion, restarting\n");
+		data->os_count = 0;
+		mpr_check_health(data, -ETIMEDOUT);
+		mpr_drdy_sync(data);
+	}
+	mutex_unlock(&data->lock);
+}
+
+/*
+ * the end of conversion trigger lets the sensor run back to back at its own
+ * conversion rate. the first conversion is started when the trigger gets
+ * enabled, after that every end of conversion fetches the result and
+ * immediately starts the next conversion.
+ */
+static int mpr_drdy_set_state(struct iio_trigger *trig, bool state)
+{
+	struct mpr_data *data = iio_trigger_get_drvdata(trig);
+	int ret = 0;
+
+	mutex_lock(&data->lock);
+	WRITE_ONCE(data->drdy_enabled, state);
+	if (state) {
+		/* drop what is left of a sum from a previous capture */
+		data->os_count = 0;
+		ret = mpr_drdy_sync(data);
+		if (ret < 0)
+			WRITE_ONCE(data->drdy_enabled, false);
+	}
+	mutex_unlock(&data->lock);
+
+	/* the watchdog does nothing once drdy_enabled is cleared */
+	if (!state || ret < 0)
+		cancel_delayed_work_sync(&data->drdy_watchdog);
+
+	/*
+	 * a conversion that is still running ends with a completion nobody
+	 * waits for, let it pass before sysfs reads use the irq again
+	 */
+	if (!state)
+		fsleep(MPR_CONV_TIME_US);
+
+	return ret;
+}
+
+static const struct iio_trigger_ops mpr_trigger_ops = {
+	.set_trigger_state = mpr_drdy_set_state,
+	.validate_device = iio_trigger_validate_own_device,
+};
+
+static void mpr_capture_drdy(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+	s32 pressure = 0;
+	int ret;
+
+	mutex_lock(&data->lock);
+	ret = mpr_read_result(data, false, &pressure);
+	if (mpr_accumulate(data, ret, pressure))
+		iio_push_to_buffers_with_timestamp(indio_dev, &data->chan,
+						   data->eoc_ts);
+	mpr_check_health(data, ret);
+
+	if (data->drdy_enabled) {
+		ret = mpr_drdy_sync(data);
+		if (ret < 0)
+			dev_err_ratelimited(data->dev,
+					    "unable to start conversion: %d\n",
+					    ret);
+	}
+	mutex_unlock(&data->lock);
+
+	iio_trigger_notify_done(indio_dev->trig);
+}
+
+/*
+ * pipelined capture keeps one conversion in flight between triggers. the
+ * conversion started by the previous trigger is normally finished by now, it
+ * gets read and the next one is started right away, so a trigger costs little
+ * more than the bus transfers and the sensor converts while nobody waits.
+ * the first trigger, or one following an error, has nothing in flight and
+ * starts the conversion itself.
+ */
+static void mpr_capture_pipelined(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+	ktime_t conv_end = 0, now;
+	unsigned int i;
+	s32 sum = 0, val;
+	int ret;
+
+	mutex_lock(&data->lock);
+	/* with oversampling every result read starts the next conversion */
+	for (i = 0; i < BIT(data->os_shift); i++) {
+		if (!data->conv_pending) {
+			ret = mpr_start_conversion(data);
+			if (ret)
+				goto err;
+		}
+
+		ret = mpr_wait_done(data);
+		if (ret < 0)
+			goto err;
+
+		/* the restart below overwrites conv_start */
+		conv_end = ktime_add_us(data->conv_start,
+					ewma_mpr_conv_read(&data->conv_time));
+		ret = mpr_read_restart(data, ret, &val);
+		if (ret)
+			goto err;
+		sum += val;
+	}
+	data->chan.pres = sum;
+
+	/*
+	 * the conversion may have ended long before this trigger, the sample
+	 * is stamped with its estimated end instead of the collection time
+	 */
+	now = ktime_get();
+	if (ktime_after(conv_end, now))
+		conv_end = now;
+	iio_push_to_buffers_with_timestamp(indio_dev, &data->chan,
+			iio_get_time_ns(indio_dev) -
+			ktime_to_ns(ktime_sub(now, conv_end)));
+
+err:
+	mpr_check_health(data, ret);
+	mutex_unlock(&data->lock);
+	iio_trigger_notify_done(indio_dev->trig);
+}
+
+/*
+ * check on the conversion of one group member and push its result once it is
+ * done and, with oversampling, enough of them are summed up.
+ * Context: data->lock must be held
+ * Return: true while the conversion is still running
+ */
+static bool mpr_group_collect(struct mpr_data *data)
+{
+	bool full = data->irq <= 0 && !data->gpiod_eoc &&
+		    data->poll_mode == MPR_POLL_RESULT;
+	s32 pressure = 0;
+	int ret;
+
+	if (data->irq > 0)
+		ret = completion_done(&data->completion);
+	else
+		ret = mpr_poll_conversion(data, full);
+
+	if (!ret) {
+		if (ktime_us_delta(ktime_get(), data->conv_start) <=
+		    mpr_conv_timeout_us(data))
+			return true;
+
+		data->err_stats.timeouts++;
+		ret = -ETIMEDOUT;
+	}
+
+	data->conv_pending = false;
+	if (ret > 0)
+		ret = mpr_read_result(data, full, &pressure);
+	if (mpr_accumulate(data, ret, pressure))
+		iio_push_to_buffers_with_timestamp(data->indio_dev, &data->chan,
+					iio_get_time_ns(data->indio_dev));
+	mpr_check_health(data, ret);
+
+	return false;
+}
+
+/*
+ * one round of a group: start the conversions of the members back to back,
+ * then collect the results in the order they become ready. members that
+ * oversample less than @round conversions sit it out.
+ */
+static void mpr_group_round(struct mpr_data **members, unsigned int num,
+			    unsigned int round)
+{
+	DECLARE_BITMAP(pending, MPR_GROUP_MAX);
+	struct mpr_data *member;
+	unsigned long first = ULONG_MAX;
+	unsigned int i;
+	ktime_t start;
+	s64 remaining;
+	int ret;
+
+	bitmap_zero(pending, MPR_GROUP_MAX);
+	start = ktime_get();
+
+	for (i = 0; i < num; i++) {
+		member = members[i];
+
+		mutex_lock(&member->lock);
+		if (!round)
+			member->os_count = 0;
+		if (round >= BIT(member->os_shift)) {
+			mutex_unlock(&member->lock);
+			continue;
+		}
+
+		ret = mpr_start_conversion(member);
+		if (ret) {
+			mpr_accumulate(member, ret, 0);
+			mpr_check_health(member, ret);
+		} else {
+			__set_bit(i, pending);
+			first = min(first,
+				    ewma_mpr_conv_read(&member->conv_time));
+		}
+		mutex_unlock(&member->lock);
+	}
+
+	/* nothing can be ready before the fastest member is expected to be */
+	remaining = (s64)first - MPR_POLL_US -
+		    ktime_us_delta(ktime_get(), start);
+	if (!bitmap_empty(pending, num) && remaining > 0)
+		fsleep(remaining);
+
+	while (!bitmap_empty(pending, num)) {
+		for_each_set_bit(i, pending, num) {
+			member = members[i];
+
+			mutex_lock(&member->lock);
+			if (!mpr_group_collect(member))
+				__clear_bit(i, pending);
+			mutex_unlock(&member->lock);
+		}
+
+		if (!bitmap_empty(pending, num))
+			usleep_range(MPR_POLL_US,
+				     MPR_POLL_US + MPR_POLL_US / 4);
+	}
+}
+
+/*
+ * the first member of a group runs the acquisition rounds of all the members
+ * and every result is pushed into the buffer of its own device. a round costs
+ * about one conversion time plus a short read per sensor instead of one
+ * conversion time per sensor. the trigger handlers of the other members have
+ * nothing left to do.
+ */
+static void mpr_group_capture(struct mpr_data *data)
+{
+	struct mpr_data *members[MPR_GROUP_MAX];
+	struct mpr_group *group = data->group;
+	struct mpr_data *member;
+	unsigned int i, num = 0, rounds = 1;
+
+	mutex_lock(&group->lock);
+
+	if (list_first_entry_or_null(&group->members, struct mpr_data,
+				     group_node) != data)
+		goto out;
+
+	list_for_each_entry(member, &group->members, group_node) {
+		members[num++] = member;
+		rounds = max_t(unsigned int, rounds, BIT(member->os_shift));
+	}
+
+	for (i = 0; i < rounds; i++)
+		mpr_group_round(members, num, i);
+
+out:
+	mutex_unlock(&group->lock);
+}
+
+static int mpr_group_join(struct mpr_data *data)
+{
+	struct iio_trigger *trig = data->indio_dev->trig;
+	struct device *bus = data->dev->parent;
+	struct mpr_group *group;
+	int ret = 0;
+
+	mutex_lock(&mpr_groups_lock);
+
+	list_for_each_entry(group, &mpr_groups, node)
+		if (group->bus == bus && group->trig == trig)
+			goto found;
+
+	group = kzalloc(sizeof(*group), GFP_KERNEL);
+	if (!group) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	group->bus = bus;
+	group->trig = trig;
+	mutex_init(&group->lock);
+	INIT_LIST_HEAD(&group->members);
+	list_add(&group->node, &mpr_groups);
+
+found:
+	if (group->users == MPR_GROUP_MAX) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	group->users++;
+	data->group = group;
+
+	mutex_lock(&group->lock);
+	list_add_tail(&data->group_node, &group->members);
+	mutex_unlock(&group->lock);
+
+out:
+	mutex_unlock(&mpr_groups_lock);
+
+	return ret;
+}
+
+/* called before the trigger is detached, no more pushes into our buffer */
+static void mpr_group_leave(struct mpr_data *data)
+{
+	struct mpr_group *group = data->group;
+
+	mutex_lock(&group->lock);
+	list_del_init(&data->group_node);
+	mutex_unlock(&group->lock);
+}
+
+/* called once our own trigger handler can no longer run */
+static void mpr_group_put(struct mpr_data *data)
+{
+	struct mpr_group *group = data->group;
+
+	mutex_lock(&mpr_groups_lock);
+
+	data->group = NULL;
+	if (!--group->users) {
+		list_del(&group->node);
+		mutex_destroy(&group->lock);
+		kfree(group);
+	}
+
+	mutex_unlock(&mpr_groups_lock);
+}
+
+static void mpr_capture(struct iio_dev *indio_dev)
+{
+	int ret;
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	if (iio_trigger_using_own(indio_dev)) {
+		mpr_capture_drdy(indio_dev);
+		return;
+	}
+
+	if (data->group) {
+		mpr_group_capture(data);
+		iio_trigger_notify_done(indio_dev->trig);
+		return;
+	}
+
+	if (data->pipelined) {
+		mpr_capture_pipelined(indio_dev);
+		return;
+	}
+
+	mutex_lock(&data->lock);
+	ret = mpr_read_oversampled(data, &data->chan.pres);
+	if (ret < 0)
+		goto err;
+
+	iio_push_to_buffers_with_timestamp(indio_dev, &data->chan,
+					   iio_get_time_ns(indio_dev));
+
+err:
+	mpr_check_health(data, ret);
+	mutex_unlock(&data->lock);
+	iio_trigger_notify_done(indio_dev->trig);
+}
+
+static void mpr_rt_work(struct kthread_work *work)
+{
+	struct mpr_data *data = container_of(work, struct mpr_data, rt.work);
+
+	mpr_capture(data->indio_dev);
+}
+
+/*
+ * With a real-time capture thread running, the conversion is started from
+ * that thread instead of the pollfunc irq thread. The work is queued right
+ * from the hard irq of the trigger.
+ */
+static irqreturn_t mpr_trigger_top_half(int irq, void *p)
+{
+	struct iio_poll_func *pf = p;
+	struct mpr_data *data = iio_priv(pf->indio_dev);
+
+	if (!iio_rt_capture_queue(&data->rt))
+		return IRQ_WAKE_THREAD;
+
+	return IRQ_HANDLED;
+}
+
+static irqreturn_t mpr_trigger_handler(int irq, void *p)
+{
+	struct iio_poll_func *pf = p;
+	struct iio_dev *indio_dev = pf->indio_dev;
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	/* nested triggers end up here without passing through the top half */
+	if (iio_rt_capture_queue(&data->rt))
+		return IRQ_HANDLED;
+
+	mpr_capture(indio_dev);
+
+	return IRQ_HANDLED;
+}
+
+static int mpr_buffer_preenable(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	return iio_rt_capture_start(&data->rt, data->dev);
+}
+
+/* prime the pipeline so that the first trigger already finds a result */
+static int mpr_buffer_postenable(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+	int ret;
+
+	if (iio_trigger_using_own(indio_dev))
+		return 0;
+
+	if (data->group_capture)
+		return mpr_group_join(data);
+
+	if (!data->pipelined)
+		return 0;
+
+	mutex_lock(&data->lock);
+	ret = mpr_start_conversion(data);
+	mutex_unlock(&data->lock);
+
+	return ret;
+}
+
+static int mpr_buffer_predisable(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	if (data->group)
+		mpr_group_leave(data);
+
+	return 0;
+}
+
+static int mpr_buffer_postdisable(struct iio_dev *indio_dev)
+{
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	if (data->group)
+		mpr_group_put(data);
+
+	/* let the conversion still in flight end before direct reads resume */
+	mutex_lock(&data->lock);
+	if (data->conv_pending)
+		mpr_wait_done(data);
+	mutex_unlock(&data->lock);
+
+	iio_rt_capture_stop(&data->rt);
+
+	return 0;
+}
+
+static const struct iio_buffer_setup_ops mpr_buffer_setup_ops = {
+	.preenable = mpr_buffer_preenable,
+	.postenable = mpr_buffer_postenable,
+	.predisable = mpr_buffer_predisable,
+	.postdisable = mpr_buffer_postdisable,
+};
+
+/*
+ * concurrent sysfs readers queue up on the iio device lock. each reader
+ * notes the sequence number of the last completed conversion when it arrives,
+ * if another conversion completed while it was queued then that result is not
+ * older than the reader and is shared instead of starting a new conversion.
+ * Context: data->lock must not be held
+ */
+static int mpr_read_shared(struct mpr_data *data, unsigned long seq,
+			   s32 *press)
+{
+	int ret = 0;
+
+	mutex_lock(&data->lock);
+	if (data->conv_seq && (data->conv_seq != seq ||
+	    ktime_ms_delta(ktime_get(), data->last_time) < data->max_age_ms)) {
+		*press = data->last_pres;
+		goto out;
+	}
+
+	ret = mpr_read_oversampled(data, press);
+	mpr_check_health(data, ret);
+	if (ret)
+		goto out;
+
+	data->last_pres = *press;
+	data->last_time = ktime_get();
+	WRITE_ONCE(data->conv_seq, data->conv_seq + 1);
+
+out:
+	mutex_unlock(&data->lock);
+
+	return ret;
+}
+
+/*
+ * the reported value is the sum of 2^os_shift conversions, so the scale is
+ * divided and the offset multiplied by the oversampling ratio
+ */
+static void mpr_calc_conv(struct mpr_data *data)
+{
+	s64 scale, offset;
+
+	/* use 64 bit calculation for preserving a reasonable precision */
+	scale = div_s64(((s64)(data->pmax - data->pmin)) * NANO,
+			data->outmax - data->outmin);
+	/*
+	 * multiply with NANO before dividing by scale and later divide by NANO
+	 * again.
+	 */
+	offset = ((-1LL) * (s64)data->outmin) * NANO -
+		  div_s64(div_s64((s64)data->pmin * NANO, scale), NANO);
+	offset *= 1 << data->os_shift;
+	data->offset = div_s64_rem(offset, NANO, &data->offset2);
+
+	scale = div_s64(((s64)(data->pmax - data->pmin)) * NANO,
+			(data->outmax - data->outmin) << data->os_shift);
+	data->scale = div_s64_rem(scale, NANO, &data->scale2);
+}
+
+static const int mpr_os_ratios[] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+
+static int mpr_read_raw(struct iio_dev *indio_dev,
+	struct iio_chan_spec const *chan, int *val, int *val2, long mask)
+{
+	int ret;
+	s32 pressure;
+	unsigned long seq;
+	struct mpr_data *data = iio_priv(indio_dev);
+
+	if (chan->type != IIO_PRESSURE)
+		return -EINVAL;
+
+	switch (mask) {
+	case IIO_CHAN_INFO_RAW:
+		seq = READ_ONCE(data->conv_seq);
+		/* the eoc irq belongs to the trigger while the buffer runs */
+		ret = iio_device_claim_direct_mode(indio_dev);
+		if (ret)
+			return ret;
+		ret = mpr_read_shared(data, seq, &pressure);
+		iio_device_release_direct_mode(indio_dev);
+		if (ret < 0)
+			return ret;
+		*val = pressure;
+		return IIO_VAL_INT;
+	case IIO_CHAN_INFO_SCALE:
+		*val = data->scale;
+		*val2 = data->scale2;
+		return IIO_VAL_INT_PLUS_NANO;
+	case IIO_CHAN_INFO_OFFSET:
+		*val = data->offset;
+		*val2 = data->offset2;
+		return IIO_VAL_INT_PLUS_NANO;
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		*val = BIT(data->os_shift);
+		return IIO_VAL_INT;
+	default:
+		return -EINVAL;
+	}
+}
 
-static void mpr_reset(struct mpr_data *data)
+static int mpr_read_avail(struct iio_dev *indio_dev,
+			  struct iio_chan_spec const *chan, const int **vals,
+			  int *type, int *length, long mask)
 {
-	if (data->gpiod_reset) {
-		gpiod_set_value(data->gpiod_reset, 0);
-		udelay(10);
-		gpiod_set_value(data->gpiod_reset, 1);
+	switch (mask) {
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		*vals = mpr_os_ratios;
+		*type = IIO_VAL_INT;
+		*length = ARRAY_SIZE(mpr_os_ratios);
+		return IIO_AVAIL_LIST;
+	default:
+		return -EINVAL;
 	}
 }
 
-/**
- * mpr_read_pressure() - Read pressure value from sensor
- * @data: Pointer to private data struct.
- * @press: Output value read from sensor.
- *
- * Reading from the sensor by sending and receiving telegrams.
- *
- * If there is an end of conversion (EOC) interrupt registered the function
- * waits for a maximum of one second for the interrupt.
- *
- * Context: The function can sleep and data->lock should be held when calling it
- * Return:
- * * 0		- OK, the pressure value could be read
- * * -ETIMEDOUT	- Timeout while waiting for the EOC interrupt or busy flag is
- *		  still set after nloops attempts of reading
- */
-static int mpr_read_pressure(struct mpr_data *data, s32 *press)
+static int mpr_write_raw(struct iio_dev *indio_dev,
+			 struct iio_chan_spec const *chan, int val, int val2,
+			 long mask)
 {
-	struct device *dev = data->dev;
-	int ret, i;
-	int nloops = 10;
+	struct mpr_data *data = iio_priv(indio_dev);
+	int ret;
 
-	reinit_completion(&data->completion);
+	switch (mask) {
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		if (val < 1 || val > BIT(MPR_OS_SHIFT_MAX) ||
+		    !is_power_of_2(val))
+			return -EINVAL;
 
-	ret = data->ops->write(data, MPR_CMD_SYNC, MPR_PKT_SYNC_LEN);
-	if (ret < 0) {
-		dev_err(dev, "error while writing ret: %d\n", ret);
-		return ret;
-	}
+		/* scale and offset must not change under a running buffer */
+		ret = iio_device_claim_direct_mode(indio_dev);
+		if (ret)
+			return ret;
 
-	if (data->irq > 0) {
-		ret = wait_for_completion_timeout(&data->completion, HZ);
-		if (!ret) {
-			dev_err(dev, "timeout while waiting for eoc irq\n");
-			return -ETIMEDOUT;
-		}
-	} else {
-		/* wait until status indicates data is ready */
-		for (i = 0; i < nloops; i++) {
-			/*
-			 * datasheet only says to wait at least 5 ms for the
-			 * data but leave the maximum response time open
-			 * --> let's try it nloops (10) times which seems to be
-			 *     quite long
-			 */
-			usleep_range(5000, 10000);
-			ret = data->ops->read(data, MPR_CMD_NOP, 1);
-			if (ret < 0) {
-				dev_err(dev,
-					"error while reading, status: %d\n",
-					ret);
-				return ret;
-			}
-			if (!(data->buffer[0] & MPR_ST_ERR_FLAG))
-				break;
-		}
-		if (i == nloops) {
-			dev_err(dev, "timeout while reading\n");
-			return -ETIMEDOUT;
-		}
+		mutex_lock(&data->lock);
+		data->os_shift = ilog2(val);
+		mpr_calc_conv(data);
+		/* cached and partial results were summed up with the old ratio */
+		WRITE_ONCE(data->conv_seq, 0);
+		data->os_count = 0;
+		mutex_unlock(&data->lock);
+
+		iio_device_release_direct_mode(indio_dev);
+
+		return 0;
+	default:
+		return -EINVAL;
 	}
+}
 
-	ret = data->ops->read(data, MPR_CMD_NOP, MPR_PKT_NOP_LEN);
-	if (ret < 0)
+static ssize_t conversion_time_us_show(struct device *dev,
+				       struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	unsigned long conv_us;
+
+	mutex_lock(&data->lock);
+	conv_us = ewma_mpr_conv_read(&data->conv_time);
+	mutex_unlock(&data->lock);
+
+	return sysfs_emit(buf, "%lu\n", conv_us);
+}
+
+static ssize_t conversion_polls_show(struct device *dev,
+				     struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	unsigned long conversions, polls;
+
+	mutex_lock(&data->lock);
+	conversions = data->conv_stats.conversions;
+	polls = data->conv_stats.polls;
+	mutex_unlock(&data->lock);
+
+	return sysfs_emit(buf, "%lu %lu\n", conversions, polls);
+}
+
+static ssize_t pipelined_capture_show(struct device *dev,
+				      struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%d\n", data->pipelined);
+}
+
+static ssize_t pipelined_capture_store(struct device *dev,
+				       struct device_attribute *attr,
+				       const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct mpr_data *data = iio_priv(indio_dev);
+	bool enable;
+	int ret;
+
+	ret = kstrtobool(buf, &enable);
+	if (ret)
 		return ret;
 
-	if (data->buffer[0] & MPR_ST_ERR_FLAG) {
-		dev_err(data->dev,
-			"unexpected status byte %02x\n", data->buffer[0]);
-		return -ETIMEDOUT;
-	}
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
 
-	*press = get_unaligned_be24(&data->buffer[1]);
+	data->pipelined = enable;
+	iio_device_release_direct_mode(indio_dev);
 
-	dev_dbg(dev, "received: %*ph cnt: %d\n", ret, data->buffer, *press);
+	return len;
+}
 
-	return 0;
+static const char * const mpr_poll_modes[] = {
+	[MPR_POLL_STATUS] = "status",
+	[MPR_POLL_RESULT] = "result",
+};
+
+static ssize_t poll_mode_show(struct device *dev,
+			      struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%s\n", mpr_poll_modes[data->poll_mode]);
 }
 
-static irqreturn_t mpr_eoc_handler(int irq, void *p)
+static ssize_t poll_mode_store(struct device *dev,
+			       struct device_attribute *attr,
+			       const char *buf, size_t len)
 {
-	struct mpr_data *data = p;
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	int mode;
 
-	complete(&data->completion);
+	mode = sysfs_match_string(mpr_poll_modes, buf);
+	if (mode < 0)
+		return mode;
 
-	return IRQ_HANDLED;
+	mutex_lock(&data->lock);
+	data->poll_mode = mode;
+	mutex_unlock(&data->lock);
+
+	return len;
 }
 
-static irqreturn_t mpr_trigger_handler(int irq, void *p)
+static ssize_t raw_max_age_ms_show(struct device *dev,
+				   struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", READ_ONCE(data->max_age_ms));
+}
+
+static ssize_t raw_max_age_ms_store(struct device *dev,
+				    struct device_attribute *attr,
+				    const char *buf, size_t len)
 {
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 age;
 	int ret;
-	struct iio_poll_func *pf = p;
-	struct iio_dev *indio_dev = pf->indio_dev;
-	struct mpr_data *data = iio_priv(indio_dev);
+
+	ret = kstrtou32(buf, 0, &age);
+	if (ret)
+		return ret;
 
 	mutex_lock(&data->lock);
-	ret = mpr_read_pressure(data, &data->chan.pres);
-	if (ret < 0)
-		goto err;
+	data->max_age_ms = age;
+	mutex_unlock(&data->lock);
 
-	iio_push_to_buffers_with_timestamp(indio_dev, &data->chan,
-					   iio_get_time_ns(indio_dev));
+	return len;
+}
 
-err:
+static ssize_t timeout_margin_pct_show(struct device *dev,
+				       struct device_attribute *attr,
+				       char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->timeout_margin_pct);
+}
+
+static ssize_t timeout_margin_pct_store(struct device *dev,
+					struct device_attribute *attr,
+					const char *buf, size_t len)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 pct;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &pct);
+	if (ret)
+		return ret;
+
+	if (pct > MPR_TIMEOUT_MARGIN_MAX)
+		return -EINVAL;
+
+	mutex_lock(&data->lock);
+	data->timeout_margin_pct = pct;
 	mutex_unlock(&data->lock);
-	iio_trigger_notify_done(indio_dev->trig);
 
-	return IRQ_HANDLED;
+	return len;
 }
 
-static int mpr_read_raw(struct iio_dev *indio_dev,
-	struct iio_chan_spec const *chan, int *val, int *val2, long mask)
+static ssize_t reset_threshold_show(struct device *dev,
+				    struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->reset_threshold);
+}
+
+static ssize_t reset_threshold_store(struct device *dev,
+				     struct device_attribute *attr,
+				     const char *buf, size_t len)
 {
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 threshold;
 	int ret;
-	s32 pressure;
+
+	ret = kstrtou32(buf, 0, &threshold);
+	if (ret)
+		return ret;
+
+	mutex_lock(&data->lock);
+	data->reset_threshold = threshold;
+	mutex_unlock(&data->lock);
+
+	return len;
+}
+
+static ssize_t error_timeouts_show(struct device *dev,
+				   struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", data->err_stats.timeouts);
+}
+
+static ssize_t error_status_show(struct device *dev,
+				 struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", data->err_stats.status);
+}
+
+static ssize_t error_bus_show(struct device *dev,
+			      struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", data->err_stats.bus);
+}
+
+static ssize_t error_resets_show(struct device *dev,
+				 struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lu\n", data->err_stats.resets);
+}
+
+static ssize_t recovery_time_us_show(struct device *dev,
+				     struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%lld\n", data->err_stats.recovery_us);
+}
+
+static ssize_t group_capture_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%d\n", data->group_capture);
+}
+
+static ssize_t group_capture_store(struct device *dev,
+				   struct device_attribute *attr,
+				   const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
 	struct mpr_data *data = iio_priv(indio_dev);
+	bool enable;
+	int ret;
 
-	if (chan->type != IIO_PRESSURE)
-		return -EINVAL;
+	ret = kstrtobool(buf, &enable);
+	if (ret)
+		return ret;
 
-	switch (mask) {
-	case IIO_CHAN_INFO_RAW:
-		mutex_lock(&data->lock);
-		ret = mpr_read_pressure(data, &pressure);
-		mutex_unlock(&data->lock);
-		if (ret < 0)
-			return ret;
-		*val = pressure;
-		return IIO_VAL_INT;
-	case IIO_CHAN_INFO_SCALE:
-		*val = data->scale;
-		*val2 = data->scale2;
-		return IIO_VAL_INT_PLUS_NANO;
-	case IIO_CHAN_INFO_OFFSET:
-		*val = data->offset;
-		*val2 = data->offset2;
-		return IIO_VAL_INT_PLUS_NANO;
-	default:
-		return -EINVAL;
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	data->group_capture = enable;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+
+/*
+ * a burst returns consecutive pressure samples out of a single sysfs read.
+ * the conversions run back to back like in pipelined capture, reading a
+ * result also starts the next conversion and only the last one is read
+ * without a restart. every line holds the timestamp taken once the sample
+ * was read and the raw pressure, a sum of 2^os_shift conversions. the mlock
+ * and data->lock are held throughout, so a burst is limited to
+ * MPR_BURST_CONV_MAX conversions, which still fit one sample at the highest
+ * oversampling ratio.
+ */
+static int mpr_get_burst(struct mpr_data *data, char *buf)
+{
+	unsigned int i, total;
+	s32 sum = 0, val;
+	int len = 0;
+	int ret;
+
+	mutex_lock(&data->lock);
+	/* the oversampling ratio may have grown since burst_len was set */
+	total = min_t(u32, data->burst_len << data->os_shift,
+		      MPR_BURST_CONV_MAX);
+	ret = mpr_start_conversion(data);
+	for (i = 1; !ret && i <= total; i++) {
+		ret = mpr_wait_done(data);
+		if (ret >= 0 && i < total)
+			ret = mpr_read_restart(data, ret, &val);
+		else if (ret >= 0)
+			ret = mpr_read_result(data, ret, &val);
+		if (ret)
+			break;
+
+		sum += val;
+		if (i % BIT(data->os_shift))
+			continue;
+
+		len += sysfs_emit_at(buf, len, "%lld %d\n",
+				     iio_get_time_ns(data->indio_dev), sum);
+		/* concurrent in_pressure_raw readers can take the last one */
+		data->last_pres = sum;
+		data->last_time = ktime_get();
+		WRITE_ONCE(data->conv_seq, data->conv_seq + 1);
+		sum = 0;
 	}
+	mpr_check_health(data, ret);
+	mutex_unlock(&data->lock);
+
+	return ret ?: len;
+}
+
+static ssize_t in_pressure_raw_burst_show(struct device *dev,
+					  struct device_attribute *attr,
+					  char *buf)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct mpr_data *data = iio_priv(indio_dev);
+	int ret;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	ret = mpr_get_burst(data, buf);
+	iio_device_release_direct_mode(indio_dev);
+
+	return ret;
+}
+
+static ssize_t in_pressure_raw_burst_store(struct device *dev,
+					   struct device_attribute *attr,
+					   const char *buf, size_t len)
+{
+	struct mpr_data *data = iio_priv(dev_to_iio_dev(dev));
+	u32 count;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &count);
+	if (ret)
+		return ret;
+
+	if (!count || count > MPR_BURST_MAX)
+		return -EINVAL;
+
+	mutex_lock(&data->lock);
+	if (count << data->os_shift > MPR_BURST_CONV_MAX)
+		ret = -EINVAL;
+	else
+		data->burst_len = count;
+	mutex_unlock(&data->lock);
+
+	return ret ?: len;
 }
 
+IIO_RT_CAPTURE_DEVICE_ATTRS(struct mpr_data, rt);
+static IIO_DEVICE_ATTR_RO(conversion_time_us, 0);
+static IIO_DEVICE_ATTR_RO(conversion_polls, 0);
+static IIO_DEVICE_ATTR_RW(pipelined_capture, 0);
+static IIO_DEVICE_ATTR_RW(group_capture, 0);
+static IIO_DEVICE_ATTR_RW(poll_mode, 0);
+static IIO_DEVICE_ATTR_RW(raw_max_age_ms, 0);
+static IIO_DEVICE_ATTR_RW(in_pressure_raw_burst, 0);
+static IIO_DEVICE_ATTR_RW(timeout_margin_pct, 0);
+static IIO_DEVICE_ATTR_RW(reset_threshold, 0);
+static IIO_DEVICE_ATTR_RO(error_timeouts, 0);
+static IIO_DEVICE_ATTR_RO(error_status, 0);
+static IIO_DEVICE_ATTR_RO(error_bus, 0);
+static IIO_DEVICE_ATTR_RO(error_resets, 0);
+static IIO_DEVICE_ATTR_RO(recovery_time_us, 0);
+static IIO_CONST_ATTR(poll_mode_available, "status result");
+
+static struct attribute *mpr_attrs[] = {
+	IIO_RT_CAPTURE_ATTRS,
+	&iio_dev_attr_conversion_time_us.dev_attr.attr,
+	&iio_dev_attr_conversion_polls.dev_attr.attr,
+	&iio_dev_attr_pipelined_capture.dev_attr.attr,
+	&iio_dev_attr_group_capture.dev_attr.attr,
+	&iio_dev_attr_poll_mode.dev_attr.attr,
+	&iio_const_attr_poll_mode_available.dev_attr.attr,
+	&iio_dev_attr_raw_max_age_ms.dev_attr.attr,
+	&iio_dev_attr_in_pressure_raw_burst.dev_attr.attr,
+	&iio_dev_attr_timeout_margin_pct.dev_attr.attr,
+	&iio_dev_attr_reset_threshold.dev_attr.attr,
+	&iio_dev_attr_error_timeouts.dev_attr.attr,
+	&iio_dev_attr_error_status.dev_attr.attr,
+	&iio_dev_attr_error_bus.dev_attr.attr,
+	&iio_dev_attr_error_resets.dev_attr.attr,
+	&iio_dev_attr_recovery_time_us.dev_attr.attr,
+	NULL
+};
+
+static const struct attribute_group mpr_attr_group = {
+	.attrs = mpr_attrs,
+};
+
 static const struct iio_info mpr_info = {
 	.read_raw = &mpr_read_raw,
+	.read_avail = &mpr_read_avail,
+	.write_raw = &mpr_write_raw,
+	.attrs = &mpr_attr_group,
 };
 
 int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
@@ -330,7 +1609,6 @@ int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
 	struct mpr_data *data;
 	struct iio_dev *indio_dev;
 	const char *triplet;
-	s64 scale, offset;
 	u32 func;
 
 	indio_dev = devm_iio_device_alloc(dev, sizeof(*data));
@@ -339,11 +1617,21 @@ int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
 
 	data = iio_priv(indio_dev);
 	data->dev = dev;
+	data->indio_dev = indio_dev;
 	data->ops = ops;
 	data->irq = irq;
+	data->poll_mode = ops->poll_mode;
+	data->timeout_margin_pct = MPR_TIMEOUT_MARGIN_PCT;
+	data->reset_threshold = MPR_RESET_THRESHOLD;
+	data->burst_len = 1;
 
 	mutex_init(&data->lock);
 	init_completion(&data->completion);
+	INIT_DELAYED_WORK(&data->drdy_watchdog, mpr_drdy_watchdog);
+	ewma_mpr_conv_init(&data->conv_time);
+	ewma_mpr_conv_add(&data->conv_time, MPR_CONV_INIT_US);
+	INIT_LIST_HEAD(&data->group_node);
+	iio_rt_capture_init(&data->rt, mpr_rt_work);
 
 	indio_dev->name = "mprls0025pa";
 	indio_dev->info = &mpr_info;
@@ -405,17 +1693,7 @@ int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
 	data->outmin = mpr_func_spec[data->function].output_min;
 	data->outmax = mpr_func_spec[data->function].output_max;
 
-	/* use 64 bit calculation for preserving a reasonable precision */
-	scale = div_s64(((s64)(data->pmax - data->pmin)) * NANO,
-			data->outmax - data->outmin);
-	data->scale = div_s64_rem(scale, NANO, &data->scale2);
-	/*
-	 * multiply with NANO before dividing by scale and later divide by NANO
-	 * again.
-	 */
-	offset = ((-1LL) * (s64)data->outmin) * NANO -
-		  div_s64(div_s64((s64)data->pmin * NANO, scale), NANO);
-	data->offset = div_s64_rem(offset, NANO, &data->offset2);
+	mpr_calc_conv(data);
 
 	if (data->irq > 0) {
 		ret = devm_request_irq(dev, data->irq, mpr_eoc_handler,
@@ -425,6 +1703,22 @@ int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
 		if (ret)
 			return dev_err_probe(dev, ret,
 					  "request irq %d failed\n", data->irq);
+
+		data->trig = devm_iio_trigger_alloc(dev, "%s-dev%d",
+						    indio_dev->name,
+						    iio_device_id(indio_dev));
+		if (!data->trig)
+			return -ENOMEM;
+
+		data->trig->ops = &mpr_trigger_ops;
+		iio_trigger_set_drvdata(data->trig, data);
+
+		ret = devm_iio_trigger_register(dev, data->trig);
+		if (ret)
+			return dev_err_probe(dev, ret,
+					     "unable to register trigger\n");
+
+		indio_dev->trig = iio_trigger_get(data->trig);
 	}
 
 	data->gpiod_reset = devm_gpiod_get_optional(dev, "reset",
@@ -435,8 +1729,18 @@ int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq)
 
 	mpr_reset(data);
 
-	ret = devm_iio_triggered_buffer_setup(dev, indio_dev, NULL,
-					      mpr_trigger_handler, NULL);
+	/* an eoc irq is preferred, the gpio is only polled */
+	if (data->irq <= 0) {
+		data->gpiod_eoc = devm_gpiod_get_optional(dev, "eoc", GPIOD_IN);
+		if (IS_ERR(data->gpiod_eoc))
+			return dev_err_probe(dev, PTR_ERR(data->gpiod_eoc),
+					     "request eoc-gpio failed\n");
+	}
+
+	ret = devm_iio_triggered_buffer_setup(dev, indio_dev,
+					      mpr_trigger_top_half,
+					      mpr_trigger_handler,
+					      &mpr_buffer_setup_ops);
 	if (ret)
 		return dev_err_probe(dev, ret,
 				     "iio triggered buffer setup failed\n");
@@ -453,3 +1757,4 @@ EXPORT_SYMBOL_NS(mpr_common_probe, IIO_HONEYWELL_MPRLS0025PA);
 MODULE_AUTHOR("Andreas Klinger <ak@it-klinger.de>");
 MODULE_DESCRIPTION("Honeywell MPR pressure sensor core driver");
 MODULE_LICENSE("GPL");
+MODULE_IMPORT_NS(IIO_RT_CAPTURE);
@@ -11,29 +11,54 @@
 #ifndef _MPRLS0025PA_H
 #define _MPRLS0025PA_H
 
+#include <linux/average.h>
 #include <linux/completion.h>
 #include <linux/delay.h>
 #include <linux/device.h>
+#include <linux/ktime.h>
+#include <linux/list.h>
 #include <linux/mutex.h>
 #include <linux/stddef.h>
 #include <linux/types.h>
+#include <linux/workqueue.h>
 
 #include <linux/iio/iio.h>
 
+#include "../iio_rt_capture/iio_rt_capture.h"
+
 #define MPR_MEASUREMENT_RD_SIZE 4
 #define MPR_CMD_NOP      0xf0
 #define MPR_CMD_SYNC     0xaa
 #define MPR_PKT_NOP_LEN  MPR_MEASUREMENT_RD_SIZE
 #define MPR_PKT_SYNC_LEN 3
+#define MPR_NUM_CHANNELS 2
+
+#define MPR_STARTUP_TIME_US 2500
+#define MPR_CONV_TIME_US    10000
+#define MPR_CONV_INIT_US    5000
+#define MPR_TIMEOUT_MARGIN_PCT 100
+#define MPR_TIMEOUT_MARGIN_MAX 1000
+#define MPR_RESET_THRESHOLD 3
+#define MPR_GROUP_MAX       16
+#define MPR_OS_SHIFT_MAX    7
+#define MPR_BURST_MAX       64
+#define MPR_BURST_CONV_MAX  256
+#define MPR_POLL_US         200
+#define MPR_EOC_POLL_US     50
 
 struct device;
 
 struct iio_chan_spec;
 struct iio_dev;
+struct iio_trigger;
 
 struct mpr_data;
+struct mpr_group;
 struct mpr_ops;
 
+/* conversion time in microseconds, averaged with a weight of 1/8 */
+DECLARE_EWMA(mpr_conv, 4, 8)
+
 /**
  * struct mpr_chan
  * @pres: pressure value
@@ -44,6 +69,18 @@ struct mpr_chan {
 	s64 ts;
 };
 
+/**
+ * enum mpr_poll_mode - how a conversion is polled without the eoc irq
+ * @MPR_POLL_STATUS: poll the status byte only, read the result once the
+ *                   sensor is no longer busy
+ * @MPR_POLL_RESULT: poll the complete result, the first response that is no
+ *                   longer busy is the measurement
+ */
+enum mpr_poll_mode {
+	MPR_POLL_STATUS,
+	MPR_POLL_RESULT,
+};
+
 enum mpr_func_id {
 	MPR_FUNCTION_A,
 	MPR_FUNCTION_B,
@@ -53,6 +90,7 @@ enum mpr_func_id {
 /**
  * struct mpr_data
  * @dev: current device structure
+ * @indio_dev: iio device this structure is private to
  * @ops: functions that implement the sensor reads/writes, bus init
  * @lock: access to device during read
  * @pmin: minimal pressure in pascal
@@ -60,19 +98,65 @@ enum mpr_func_id {
  * @function: transfer function
  * @outmin: minimum raw pressure in counts (based on transfer function)
  * @outmax: maximum raw pressure in counts (based on transfer function)
- * @scale: pressure scale
+ * @scale: pressure scale, for the current oversampling ratio
  * @scale2: pressure scale, decimal number
- * @offset: pressure offset
+ * @offset: pressure offset, for the current oversampling ratio
  * @offset2: pressure offset, decimal number
+ * @os_shift: log2 of the oversampling ratio, 2^os_shift conversions are summed
+ *            up into every reported value
+ * @os_sum: conversions summed up so far in buffered mode
+ * @os_count: number of conversions in @os_sum
  * @gpiod_reset: reset
+ * @gpiod_eoc: end of conversion pin on a gpio without irq support, polled
+ *             instead of the status byte
+ * @ready_time: time after which the sensor accepts measurement commands
  * @irq: end of conversion irq. used to distinguish between irq mode and
  *       reading in a loop until data is ready
  * @completion: handshake from irq to read
+ * @trig: data ready trigger fired by the end of conversion irq
+ * @drdy_enabled: true while @trig is enabled, every end of conversion then
+ *                fires @trig instead of signaling @completion
+ * @eoc_ts: time of the last end of conversion irq that fired @trig
+ * @drdy_watchdog: restarts the conversions of the trigger if no end of
+ *                 conversion shows up within mpr_conv_timeout_us()
+ * @pipelined: start the next conversion right after reading the result in
+ *             buffered mode, see mpr_capture_pipelined()
+ * @conv_pending: a conversion was started and its result was not read yet
+ * @conv_start: time the last conversion was started
+ * @poll_mode: how the status is polled, defaults to mpr_ops.poll_mode
+ * @conv_time: conversion time learned while polling the status
+ * @conv_stats: polling statistics
+ * @conv_stats.conversions: conversions waited for by polling
+ * @conv_stats.polls: status reads done while waiting
+ * @conv_seq: number of conversions completed for sysfs readers
+ * @last_pres: result of the last conversion done for a sysfs reader
+ * @last_time: time @last_pres was read
+ * @max_age_ms: sysfs readers get @last_pres without a new conversion if it is
+ *              younger than this, 0 disables it
+ * @burst_len: number of pressure samples returned by a burst read
+ * @timeout_margin_pct: conversion timeout in percent on top of
+ *                      MPR_CONV_TIME_US
+ * @reset_threshold: consecutive failed reads after which the sensor is reset,
+ *                   0 disables the automatic reset
+ * @fail_streak: consecutive failed reads
+ * @fail_start: time of the first failure of the current streak
+ * @err_stats: error statistics
+ * @err_stats.timeouts: conversions that did not end in time
+ * @err_stats.status: results with an unexpected status byte
+ * @err_stats.bus: failed bus transfers
+ * @err_stats.resets: automatic resets
+ * @err_stats.recovery_us: time from the first failure to the next good read,
+ *                         for the last streak of failures
+ * @group_capture: join a capture group when the buffer gets enabled
+ * @group: capture group, present while the buffer is enabled in group mode
+ * @group_node: entry in the member list of @group
+ * @rt: real-time capture thread
  * @chan: channel values for buffered mode
  * @buffer: raw conversion data
  */
 struct mpr_data {
 	struct device		*dev;
+	struct iio_dev		*indio_dev;
 	const struct mpr_ops	*ops;
 	struct mutex		lock;
 	u32			pmin;
@@ -84,19 +168,71 @@ struct mpr_data {
 	int			scale2;
 	int			offset;
 	int			offset2;
+	u8			os_shift;
+	s32			os_sum;
+	unsigned int		os_count;
 	struct gpio_desc	*gpiod_reset;
+	struct gpio_desc	*gpiod_eoc;
+	ktime_t			ready_time;
 	int			irq;
 	struct completion	completion;
+	struct iio_trigger	*trig;
+	bool			drdy_enabled;
+	s64			eoc_ts;
+	struct delayed_work	drdy_watchdog;
+	bool			pipelined;
+	bool			conv_pending;
+	ktime_t			conv_start;
+	enum mpr_poll_mode	poll_mode;
+	struct ewma_mpr_conv	conv_time;
+	struct {
+		unsigned long conversions;
+		unsigned long polls;
+	} conv_stats;
+	unsigned long		conv_seq;
+	s32			last_pres;
+	ktime_t			last_time;
+	u32			max_age_ms;
+	u32			burst_len;
+	u32			timeout_margin_pct;
+	u32			reset_threshold;
+	unsigned int		fail_streak;
+	ktime_t			fail_start;
+	struct {
+		unsigned long timeouts;
+		unsigned long status;
+		unsigned long bus;
+		unsigned long resets;
+		s64 recovery_us;
+	} err_stats;
+	bool			group_capture;
+	struct mpr_group	*group;
+	struct list_head	group_node;
+	struct iio_rt_capture	rt;
 	struct mpr_chan		chan;
 	u8	    buffer[MPR_MEASUREMENT_RD_SIZE] __aligned(IIO_DMA_MINALIGN);
 };
 
+/**
+ * struct mpr_ops - bus specific functions
+ * @init: bus init
+ * @read: send @cmd and read @cnt bytes into mpr_data.buffer
+ * @write: send @cmd as a @cnt byte command
+ * @read_restart: optional, read the result into mpr_data.buffer and send the
+ *                measurement command in a single bus submission
+ * @poll_mode: default polling strategy, MPR_POLL_RESULT where a full read
+ *             costs about as much as a status read
+ */
 struct mpr_ops {
 	int (*init)(struct device *dev);
 	int (*read)(struct mpr_data *data, const u8 cmd, const u8 cnt);
 	int (*write)(struct mpr_data *data, const u8 cmd, const u8 cnt);
+	int (*read_restart)(struct mpr_data *data);
+	enum mpr_poll_mode poll_mode;
 };
 
+extern const struct iio_chan_spec mpr_channels[MPR_NUM_CHANNELS];
+
 int mpr_common_probe(struct device *dev, const struct mpr_ops *ops, int irq);
 
 #endif
@@ -60,6 +60,7 @@ static const struct mpr_ops mpr_i2c_ops = {
 	.init = mpr_i2c_init,
 	.read = mpr_i2c_read,
 	.write = mpr_i2c_write,
+	.poll_mode = MPR_POLL_STATUS,
 };
 
 static int mpr_i2c_probe(struct i2c_client *client)
@@ -8,6 +8,7 @@
  *  https://prod-edam.honeywell.com/content/dam/honeywell-edam/sps/siot/en-us/products/sensors/pressure-sensors/board-mount-pressure-sensors/micropressure-mpr-series/documents/sps-siot-mpr-series-datasheet-32332628-ciid-172626.pdf
  */
 
+#include <linux/array_size.h>
 #include <linux/mod_devicetable.h>
 #include <linux/module.h>
 #include <linux/spi/spi.h>
@@ -17,6 +18,7 @@
 
 struct mpr_spi_buf {
 	u8 tx[MPR_MEASUREMENT_RD_SIZE] __aligned(IIO_DMA_MINALIGN);
+	u8 tx_sync[MPR_PKT_SYNC_LEN];
 };
 
 static int mpr_spi_init(struct device *dev)
@@ -28,6 +30,8 @@ static int mpr_spi_init(struct device *dev)
 	if (!buf)
 		return -ENOMEM;
 
+	buf->tx_sync[0] = MPR_CMD_SYNC;
+
 	spi_set_drvdata(spi, buf);
 
 	return 0;
@@ -50,10 +54,38 @@ static int mpr_spi_xfer(struct mpr_data *data, const u8 cmd, const u8 pkt_len)
 	return spi_sync_transfer(spi, &xfer, 1);
 }
 
+/*
+ * clock out the result and send the next measurement command within one
+ * message, chip select is toggled in between since every command has to
+ * start with a falling edge on it
+ */
+static int mpr_spi_read_restart(struct mpr_data *data)
+{
+	struct spi_device *spi = to_spi_device(data->dev);
+	struct mpr_spi_buf *buf = spi_get_drvdata(spi);
+	struct spi_transfer xfers[2] = {
+		{
+			.tx_buf = buf->tx,
+			.rx_buf = data->buffer,
+			.len = MPR_PKT_NOP_LEN,
+			.cs_change = 1,
+		}, {
+			.tx_buf = buf->tx_sync,
+			.len = MPR_PKT_SYNC_LEN,
+		},
+	};
+
+	buf->tx[0] = MPR_CMD_NOP;
+
+	return spi_sync_transfer(spi, xfers, ARRAY_SIZE(xfers));
+}
+
 static const struct mpr_ops mpr_spi_ops = {
 	.init = mpr_spi_init,
 	.read = mpr_spi_xfer,
 	.write = mpr_spi_xfer,
+	.read_restart = mpr_spi_read_restart,
+	.poll_mode = MPR_POLL_RESULT,
 };
 
 static int mpr_spi_probe(struct spi_device *spi)
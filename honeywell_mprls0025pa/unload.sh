@@ -3,4 +3,5 @@
 rmmod mprls0025pa_i2c
 rmmod mprls0025pa_spi
 rmmod mprls0025pa
+rmmod iio_rt_capture
 
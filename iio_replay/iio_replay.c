@@ -0,0 +1,725 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Virtual IIO device that replays a recorded capture of a hsc030pa, abp060mg
+ * or mprls0025pa buffer using the channel layout of the original driver
+ *
+ * Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+ */
+
+#include <linux/align.h>
+#include <linux/array_size.h>
+#include <linux/bitops.h>
+#include <linux/device.h>
+#include <linux/err.h>
+#include <linux/firmware.h>
+#include <linux/hrtimer.h>
+#include <linux/kernel.h>
+#include <linux/kthread.h>
+#include <linux/ktime.h>
+#include <linux/math64.h>
+#include <linux/minmax.h>
+#include <linux/module.h>
+#include <linux/platform_device.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
+#include <linux/string.h>
+#include <linux/sysfs.h>
+#include <linux/types.h>
+
+#include <linux/iio/buffer.h>
+#include <linux/iio/iio.h>
+#include <linux/iio/kfifo_buf.h>
+#include <linux/iio/sysfs.h>
+
+#include <asm/unaligned.h>
+
+#include "../honeywell_abp060mg/abp060mg.h"
+#include "../honeywell_hsc030pa/hsc030pa.h"
+#include "../honeywell_mprls0025pa/mprls0025pa.h"
+
+#define REPLAY_MAX_CHANNELS 4
+#define REPLAY_MAGIC        "iio-replay\n"
+#define REPLAY_HEADER_MAX   1024
+#define REPLAY_FULL_WAIT_NS (1 * NSEC_PER_MSEC)
+
+static char *layout = "hsc030pa";
+module_param(layout, charp, 0444);
+MODULE_PARM_DESC(layout,
+		 "channel layout: hsc030pa, hsc030pa_t8, abp060mg, abp060mg_t, "
+		 "abp060mg_t8 or mprls0025pa");
+
+static char *capture = "iio_replay.bin";
+module_param(capture, charp, 0444);
+MODULE_PARM_DESC(capture, "capture file, looked up as firmware");
+
+/**
+ * struct replay_layout - channels of one of the supported drivers
+ * @name: layout name, also used as the name of the iio device
+ * @channels: channel specification exported by the original driver
+ * @num_channels: number of channels, including the timestamp
+ */
+struct replay_layout {
+	const char *name;
+	const struct iio_chan_spec *channels;
+	unsigned int num_channels;
+};
+
+static const struct replay_layout replay_layouts[] = {
+	{ "hsc030pa", hsc_channels, ARRAY_SIZE(hsc_channels) },
+	{ "hsc030pa_t8", hsc_channels_t8, ARRAY_SIZE(hsc_channels_t8) },
+	{ "abp060mg", abp060mg_p_channel, ARRAY_SIZE(abp060mg_p_channel) },
+	{ "abp060mg_t", abp060mg_pt_channel, ARRAY_SIZE(abp060mg_pt_channel) },
+	{ "abp060mg_t8", abp060mg_pt8_channel,
+	  ARRAY_SIZE(abp060mg_pt8_channel) },
+	{ "mprls0025pa", mpr_channels, ARRAY_SIZE(mpr_channels) },
+};
+
+/**
+ * struct replay_conv - conversion of a channel, as reported by the original
+ * @scale: scale, integer and nano parts
+ * @offset: offset, integer and nano parts
+ * @os_ratio: oversampling ratio the samples were summed up with, the nano
+ *            part is always 0
+ */
+struct replay_conv {
+	int scale[2];
+	int offset[2];
+	int os_ratio[2];
+};
+
+/**
+ * struct replay_data
+ * @dev: current device structure
+ * @fw: capture, an optional header followed by a sequence of scans with all
+ *      channels and the timestamp enabled, exactly as read from the character
+ *      device of the original
+ * @records: first scan of the capture
+ * @conv: scale and offset of each channel, taken from the capture header
+ * @scan_bytes: size of one recorded scan
+ * @offset: offset of each channel within a recorded scan
+ * @num_scans: number of scans in the capture
+ * @pos: index of the next scan to be replayed
+ * @task: replay thread, present while the buffer is enabled
+ * @speed: replay speed multiplier, 0 pushes the scans as fast as the buffer
+ *         accepts them
+ * @loop: restart from the first scan once the capture is exhausted
+ * @pushed: scans accepted by the buffer since it was enabled
+ * @overruns: scans dropped since the buffer was enabled
+ * @scan: scan being pushed, the timestamp is replaced with the replay time
+ */
+struct replay_data {
+	struct device *dev;
+	const struct firmware *fw;
+	const u8 *records;
+	struct replay_conv conv[REPLAY_MAX_CHANNELS];
+	unsigned int scan_bytes;
+	unsigned int offset[REPLAY_MAX_CHANNELS];
+	unsigned int num_scans;
+	unsigned int pos;
+	struct task_struct *task;
+	u32 speed;
+	bool loop;
+	u64 pushed;
+	u64 overruns;
+	u8 *scan;
+};
+
+static const u8 *replay_record(struct replay_data *data, unsigned int idx)
+{
+	return data->records + idx * data->scan_bytes;
+}
+
+/* the timestamp is always the last element of a scan */
+static s64 replay_record_ts(struct replay_data *data, unsigned int idx)
+{
+	return get_unaligned((const s64 *)(replay_record(data, idx) +
+					   data->scan_bytes - sizeof(s64)));
+}
+
+static void replay_wait_until(u64 deadline)
+{
+	ktime_t expires = ns_to_ktime(deadline);
+
+	set_current_state(TASK_INTERRUPTIBLE);
+	if (!kthread_should_stop())
+		schedule_hrtimeout(&expires, HRTIMER_MODE_ABS);
+	__set_current_state(TASK_RUNNING);
+}
+
+static void replay_wait_stop(void)
+{
+	for (;;) {
+		set_current_state(TASK_INTERRUPTIBLE);
+		if (kthread_should_stop())
+			break;
+		schedule();
+	}
+	__set_current_state(TASK_RUNNING);
+}
+
+static int replay_thread(void *arg)
+{
+	struct iio_dev *indio_dev = arg;
+	struct replay_data *data = iio_priv(indio_dev);
+	u64 start = ktime_get_ns();
+	s64 first_ts = replay_record_ts(data, data->pos);
+	s64 delta;
+
+	while (!kthread_should_stop()) {
+		if (data->pos == data->num_scans) {
+			if (!data->loop)
+				break;
+			data->pos = 0;
+			start = ktime_get_ns();
+			first_ts = replay_record_ts(data, 0);
+		}
+
+		/* keep the recorded spacing, divided by the speed multiplier */
+		if (data->speed) {
+			delta = replay_record_ts(data, data->pos) - first_ts;
+			if (delta > 0)
+				replay_wait_until(start + div_u64(delta,
+								  data->speed));
+			if (kthread_should_stop())
+				break;
+		}
+
+		memcpy(data->scan, replay_record(data, data->pos),
+		       data->scan_bytes);
+		if (!iio_push_to_buffers_with_timestamp(indio_dev, data->scan,
+						iio_get_time_ns(indio_dev))) {
+			data->pushed++;
+		} else if (!data->speed) {
+			/* wait for the consumer to make room, then retry */
+			replay_wait_until(ktime_get_ns() + REPLAY_FULL_WAIT_NS);
+			continue;
+		} else {
+			data->overruns++;
+		}
+		data->pos++;
+
+		if (!data->speed)
+			cond_resched();
+	}
+
+	/* the thread is reaped by the buffer predisable */
+	replay_wait_stop();
+
+	return 0;
+}
+
+static int replay_buffer_preenable(struct iio_dev *indio_dev)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+
+	data->pos = 0;
+	data->pushed = 0;
+	data->overruns = 0;
+
+	return 0;
+}
+
+static int replay_buffer_postenable(struct iio_dev *indio_dev)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+
+	data->task = kthread_run(replay_thread, indio_dev, "%s-replay",
+				 indio_dev->name);
+	if (IS_ERR(data->task)) {
+		int ret = PTR_ERR(data->task);
+
+		data->task = NULL;
+		return ret;
+	}
+
+	return 0;
+}
+
+static int replay_buffer_predisable(struct iio_dev *indio_dev)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+
+	if (data->task) {
+		kthread_stop(data->task);
+		data->task = NULL;
+	}
+
+	return 0;
+}
+
+static const struct iio_buffer_setup_ops replay_buffer_setup_ops = {
+	.preenable = replay_buffer_preenable,
+	.postenable = replay_buffer_postenable,
+	.predisable = replay_buffer_predisable,
+};
+
+static int replay_chan_value(struct iio_chan_spec const *chan, const u8 *p)
+{
+	const struct iio_scan_type *st = &chan->scan_type;
+	u32 raw;
+
+	if (st->storagebits == 16) {
+		if (st->endianness == IIO_BE)
+			raw = get_unaligned_be16(p);
+		else if (st->endianness == IIO_LE)
+			raw = get_unaligned_le16(p);
+		else
+			raw = get_unaligned((const u16 *)p);
+	} else {
+		if (st->endianness == IIO_BE)
+			raw = get_unaligned_be32(p);
+		else if (st->endianness == IIO_LE)
+			raw = get_unaligned_le32(p);
+		else
+			raw = get_unaligned((const u32 *)p);
+	}
+
+	raw = (raw >> st->shift) & GENMASK(st->realbits - 1, 0);
+	if (st->sign == 's')
+		return sign_extend32(raw, st->realbits - 1);
+
+	return raw;
+}
+
+/*
+ * RAW provides the value of the next scan in line to be replayed. SCALE,
+ * OFFSET and OVERSAMPLING_RATIO are the ones of the recorded part, as found
+ * in the capture header.
+ */
+static int replay_read_raw(struct iio_dev *indio_dev,
+			   struct iio_chan_spec const *chan, int *val,
+			   int *val2, long mask)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+	unsigned int idx;
+	int ret;
+
+	switch (mask) {
+	case IIO_CHAN_INFO_RAW:
+		ret = iio_device_claim_direct_mode(indio_dev);
+		if (ret)
+			return ret;
+
+		idx = data->pos < data->num_scans ? data->pos : 0;
+		*val = replay_chan_value(chan, replay_record(data, idx) +
+					 data->offset[chan->scan_index]);
+		iio_device_release_direct_mode(indio_dev);
+
+		return IIO_VAL_INT;
+	case IIO_CHAN_INFO_SCALE:
+		*val = data->conv[chan->scan_index].scale[0];
+		*val2 = data->conv[chan->scan_index].scale[1];
+		return IIO_VAL_INT_PLUS_NANO;
+	case IIO_CHAN_INFO_OFFSET:
+		*val = data->conv[chan->scan_index].offset[0];
+		*val2 = data->conv[chan->scan_index].offset[1];
+		return IIO_VAL_INT_PLUS_NANO;
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		*val = data->conv[chan->scan_index].os_ratio[0];
+		return IIO_VAL_INT;
+	default:
+		return -EINVAL;
+	}
+}
+
+/* the recorded samples were summed up with one ratio, the only one offered */
+static int replay_read_avail(struct iio_dev *indio_dev,
+			     struct iio_chan_spec const *chan,
+			     const int **vals, int *type, int *length,
+			     long mask)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+
+	switch (mask) {
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		*vals = data->conv[chan->scan_index].os_ratio;
+		*type = IIO_VAL_INT;
+		*length = 1;
+		return IIO_AVAIL_LIST;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int replay_write_raw(struct iio_dev *indio_dev,
+			    struct iio_chan_spec const *chan, int val,
+			    int val2, long mask)
+{
+	struct replay_data *data = iio_priv(indio_dev);
+
+	switch (mask) {
+	case IIO_CHAN_INFO_OVERSAMPLING_RATIO:
+		if (val != data->conv[chan->scan_index].os_ratio[0])
+			return -EINVAL;
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static ssize_t replay_speed_show(struct device *dev,
+				 struct device_attribute *attr, char *buf)
+{
+	struct replay_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%u\n", data->speed);
+}
+
+static ssize_t replay_speed_store(struct device *dev,
+				  struct device_attribute *attr,
+				  const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct replay_data *data = iio_priv(indio_dev);
+	u32 speed;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &speed);
+	if (ret)
+		return ret;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	data->speed = speed;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+
+static ssize_t replay_loop_show(struct device *dev,
+				struct device_attribute *attr, char *buf)
+{
+	struct replay_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%d\n", data->loop);
+}
+
+static ssize_t replay_loop_store(struct device *dev,
+				 struct device_attribute *attr,
+				 const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	struct replay_data *data = iio_priv(indio_dev);
+	bool loop;
+	int ret;
+
+	ret = kstrtobool(buf, &loop);
+	if (ret)
+		return ret;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	data->loop = loop;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+
+static ssize_t replay_pushed_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct replay_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%llu\n", READ_ONCE(data->pushed));
+}
+
+static ssize_t replay_overruns_show(struct device *dev,
+				    struct device_attribute *attr, char *buf)
+{
+	struct replay_data *data = iio_priv(dev_to_iio_dev(dev));
+
+	return sysfs_emit(buf, "%llu\n", READ_ONCE(data->overruns));
+}
+
+static IIO_DEVICE_ATTR_RW(replay_speed, 0);
+static IIO_DEVICE_ATTR_RW(replay_loop, 0);
+static IIO_DEVICE_ATTR_RO(replay_pushed, 0);
+static IIO_DEVICE_ATTR_RO(replay_overruns, 0);
+
+static struct attribute *replay_attrs[] = {
+	&iio_dev_attr_replay_speed.dev_attr.attr,
+	&iio_dev_attr_replay_loop.dev_attr.attr,
+	&iio_dev_attr_replay_pushed.dev_attr.attr,
+	&iio_dev_attr_replay_overruns.dev_attr.attr,
+	NULL
+};
+
+static const struct attribute_group replay_attr_group = {
+	.attrs = replay_attrs,
+};
+
+static const struct iio_info replay_info = {
+	.read_raw = replay_read_raw,
+	.read_avail = replay_read_avail,
+	.write_raw = replay_write_raw,
+	.attrs = &replay_attr_group,
+};
+
+/*
+ * compute the offset of every element and the size of a scan that has all the
+ * channels enabled, following the natural alignment rule of the iio core
+ */
+static void replay_compute_layout(struct replay_data *data,
+				  const struct replay_layout *rl)
+{
+	const struct iio_chan_spec *chan;
+	unsigned int i, bytes, largest = 1, offset = 0;
+
+	for (i = 0; i < rl->num_channels; i++) {
+		chan = &rl->channels[i];
+		bytes = chan->scan_type.storagebits / 8;
+		offset = ALIGN(offset, bytes);
+		data->offset[chan->scan_index] = offset;
+		offset += bytes;
+		largest = max(largest, bytes);
+	}
+
+	data->scan_bytes = ALIGN(offset, largest);
+}
+
+/* the value in the capture header that an attribute name refers to */
+static int *replay_header_value(struct replay_data *data,
+				const struct replay_layout *rl,
+				const char *attr)
+{
+	const struct iio_chan_spec *chan;
+	struct replay_conv *conv;
+	char name[32];
+	unsigned int i;
+
+	for (i = 0; i < rl->num_channels; i++) {
+		chan = &rl->channels[i];
+		if (chan->type == IIO_TIMESTAMP)
+			continue;
+
+		conv = &data->conv[chan->scan_index];
+		snprintf(name, sizeof(name), "in_%s_scale",
+			 chan->type == IIO_PRESSURE ? "pressure" : "temp");
+		if (!strcmp(attr, name))
+			return conv->scale;
+
+		snprintf(name, sizeof(name), "in_%s_offset",
+			 chan->type == IIO_PRESSURE ? "pressure" : "temp");
+		if (!strcmp(attr, name))
+			return conv->offset;
+
+		if (!(chan->info_mask_separate &
+		      BIT(IIO_CHAN_INFO_OVERSAMPLING_RATIO)))
+			continue;
+
+		snprintf(name, sizeof(name), "in_%s_oversampling_ratio",
+			 chan->type == IIO_PRESSURE ? "pressure" : "temp");
+		if (!strcmp(attr, name))
+			return conv->os_ratio;
+	}
+
+	return NULL;
+}
+
+/*
+ * a capture can start with a text header that holds the scale, offset and
+ * oversampling ratio attributes of the original device, one per line and
+ * terminated by 'end':
+ *
+ *   iio-replay
+ *   in_pressure_scale 0.000762939
+ *   in_pressure_offset -1638.400000
+ *   end
+ *
+ * channels that are not listed keep a scale of 1, an offset of 0 and a ratio
+ * of 1.
+ * Return: size of the header, 0 if there is none, or a negative error code
+ */
+static int replay_parse_header(struct replay_data *data,
+			       const struct replay_layout *rl)
+{
+	const char *buf = (const char *)data->fw->data;
+	size_t size = min_t(size_t, data->fw->size, REPLAY_HEADER_MAX);
+	char line[80], attr[32], val[32];
+	size_t pos = strlen(REPLAY_MAGIC);
+	const char *eol;
+	unsigned int i;
+	int *value;
+	int ret;
+
+	for (i = 0; i < REPLAY_MAX_CHANNELS; i++)
+		data->conv[i] = (struct replay_conv){
+			.scale = { 1, 0 },
+			.os_ratio = { 1, 0 },
+		};
+
+	if (size < pos || memcmp(buf, REPLAY_MAGIC, pos))
+		return 0;
+
+	for (;;) {
+		eol = memchr(buf + pos, '\n', size - pos);
+		if (!eol || eol - (buf + pos) >= sizeof(line))
+			return dev_err_probe(data->dev, -EINVAL,
+					     "capture header is malformed\n");
+
+		memcpy(line, buf + pos, eol - (buf + pos));
+		line[eol - (buf + pos)] = '\0';
+		pos = eol - buf + 1;
+
+		if (!strcmp(line, "end"))
+			break;
+
+		if (sscanf(line, "%31s %31s", attr, val) != 2)
+			return dev_err_probe(data->dev, -EINVAL,
+					     "invalid capture header line '%s'\n",
+					     line);
+
+		value = replay_header_value(data, rl, attr);
+		if (!value)
+			return dev_err_probe(data->dev, -EINVAL,
+					     "%s does not belong to layout %s\n",
+					     attr, rl->name);
+
+		ret = iio_str_to_fixpoint(val, 100000000, &value[0],
+					  &value[1]);
+		if (ret)
+			return dev_err_probe(data->dev, ret,
+					     "invalid value for %s\n", attr);
+	}
+
+	for (i = 0; i < REPLAY_MAX_CHANNELS; i++)
+		if (data->conv[i].os_ratio[0] < 1 || data->conv[i].os_ratio[1])
+			return dev_err_probe(data->dev, -EINVAL,
+					     "invalid oversampling ratio\n");
+
+	return pos;
+}
+
+static void replay_release_fw(void *fw)
+{
+	release_firmware(fw);
+}
+
+static int replay_probe(struct platform_device *pdev)
+{
+	struct device *dev = &pdev->dev;
+	const struct replay_layout *rl = NULL;
+	struct replay_data *data;
+	struct iio_dev *indio_dev;
+	unsigned long *scan_masks;
+	unsigned int i;
+	size_t size;
+	int ret;
+
+	for (i = 0; i < ARRAY_SIZE(replay_layouts); i++)
+		if (!strcmp(layout, replay_layouts[i].name))
+			rl = &replay_layouts[i];
+	if (!rl)
+		return dev_err_probe(dev, -EINVAL, "unknown layout '%s'\n",
+				     layout);
+
+	indio_dev = devm_iio_device_alloc(dev, sizeof(*data));
+	if (!indio_dev)
+		return -ENOMEM;
+
+	data = iio_priv(indio_dev);
+	data->dev = dev;
+	data->speed = 1;
+	replay_compute_layout(data, rl);
+
+	ret = request_firmware(&data->fw, capture, dev);
+	if (ret)
+		return dev_err_probe(dev, ret, "capture %s not available\n",
+				     capture);
+
+	ret = devm_add_action_or_reset(dev, replay_release_fw,
+				       (void *)data->fw);
+	if (ret)
+		return ret;
+
+	ret = replay_parse_header(data, rl);
+	if (ret < 0)
+		return ret;
+	if (!ret)
+		dev_warn(dev,
+			 "capture has no header, scale and offset are not known\n");
+
+	data->records = data->fw->data + ret;
+	size = data->fw->size - ret;
+	if (!size || size % data->scan_bytes)
+		return dev_err_probe(dev, -EINVAL,
+				     "capture is not made of %u byte scans\n",
+				     data->scan_bytes);
+	data->num_scans = size / data->scan_bytes;
+
+	data->scan = devm_kzalloc(dev, data->scan_bytes, GFP_KERNEL);
+	if (!data->scan)
+		return -ENOMEM;
+
+	/*
+	 * scans are pushed as they were recorded, the iio core demuxes the
+	 * channels that are actually enabled by the consumer
+	 */
+	scan_masks = devm_kcalloc(dev, 2, sizeof(*scan_masks), GFP_KERNEL);
+	if (!scan_masks)
+		return -ENOMEM;
+	scan_masks[0] = GENMASK(rl->num_channels - 2, 0);
+
+	indio_dev->name = rl->name;
+	indio_dev->modes = INDIO_DIRECT_MODE;
+	indio_dev->info = &replay_info;
+	indio_dev->channels = rl->channels;
+	indio_dev->num_channels = rl->num_channels;
+	indio_dev->available_scan_masks = scan_masks;
+
+	ret = devm_iio_kfifo_buffer_setup(dev, indio_dev,
+					  &replay_buffer_setup_ops);
+	if (ret)
+		return ret;
+
+	dev_info(dev, "%u scans of %u bytes available for replay\n",
+		 data->num_scans, data->scan_bytes);
+
+	return devm_iio_device_register(dev, indio_dev);
+}
+
+static struct platform_driver replay_driver = {
+	.driver = {
+		.name = "iio_replay",
+	},
+	.probe = replay_probe,
+};
+
+static struct platform_device *replay_pdev;
+
+static int __init replay_init(void)
+{
+	int ret;
+
+	ret = platform_driver_register(&replay_driver);
+	if (ret)
+		return ret;
+
+	replay_pdev = platform_device_register_simple("iio_replay", -1,
+						      NULL, 0);
+	if (IS_ERR(replay_pdev)) {
+		platform_driver_unregister(&replay_driver);
+		return PTR_ERR(replay_pdev);
+	}
+
+	return 0;
+}
+module_init(replay_init);
+
+static void __exit replay_exit(void)
+{
+	platform_device_unregister(replay_pdev);
+	platform_driver_unregister(&replay_driver);
+}
+module_exit(replay_exit);
+
+MODULE_AUTHOR("Petre Rodan <petre.rodan@subdimension.ro>");
+MODULE_DESCRIPTION("Replay of recorded Honeywell pressure sensor captures");
+MODULE_LICENSE("GPL");
+MODULE_IMPORT_NS(IIO_HONEYWELL_ABP060MG);
+MODULE_IMPORT_NS(IIO_HONEYWELL_HSC030PA);
+MODULE_IMPORT_NS(IIO_HONEYWELL_MPRLS0025PA);
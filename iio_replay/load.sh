@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# layout is one of hsc030pa, hsc030pa_t8, abp060mg, abp060mg_t,
+# abp060mg_t8, mprls0025pa
+# the capture file needs to be placed in /lib/firmware
+
+insmod ../iio_rt_capture/iio_rt_capture.ko
+insmod ../honeywell_abp060mg/abp060mg.ko
+insmod ../honeywell_hsc030pa/hsc030pa.ko
+insmod ../honeywell_mprls0025pa/mprls0025pa.ko
+insmod iio_replay.ko layout="${1:-hsc030pa}" capture="${2:-iio_replay.bin}"
+
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+target='iio_replay'
+
+rmmod "${target}" 2>/dev/null
+
+sleep 1
+
+insmod "${target}.ko" layout="${1:-hsc030pa}" capture="${2:-iio_replay.bin}"
+
+sleep 1
+
+iio_info
+
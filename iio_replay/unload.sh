@@ -0,0 +1,4 @@
+#!/bin/bash
+
+rmmod iio_replay
+
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Real-time capture thread shared by the triggered buffers of the pressure
+ * sensor drivers
+ *
+ * the acquisition is handed over to a dedicated SCHED_FIFO kthread worker
+ * directly from the hard irq of the trigger, so the sample interval does not
+ * depend on the scheduling of the generic pollfunc irq thread.
+ *
+ * Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+ */
+
+#include <linux/cpumask.h>
+#include <linux/device.h>
+#include <linux/err.h>
+#include <linux/kernel.h>
+#include <linux/kstrtox.h>
+#include <linux/kthread.h>
+#include <linux/module.h>
+#include <linux/sched.h>
+#include <linux/sched/prio.h>
+#include <linux/sysfs.h>
+
+#include <linux/iio/iio.h>
+#include <linux/iio/sysfs.h>
+
+#include <uapi/linux/sched/types.h>
+
+#include "iio_rt_capture.h"
+
+/**
+ * iio_rt_capture_init() - set up the default real-time capture settings
+ * @rt: real-time capture state
+ * @fn: acquisition run by the capture thread
+ */
+void iio_rt_capture_init(struct iio_rt_capture *rt, kthread_work_func_t fn)
+{
+	rt->prio = 0;
+	rt->cpu = -1;
+	rt->worker = NULL;
+	kthread_init_work(&rt->work, fn);
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_init, IIO_RT_CAPTURE);
+
+/**
+ * iio_rt_capture_set_sched() - apply the real-time settings to a task
+ * @rt: real-time capture state
+ * @task: task to be elevated to SCHED_FIFO and bound to the selected cpu
+ *
+ * Return: 0 on success, negative error code otherwise
+ */
+int iio_rt_capture_set_sched(struct iio_rt_capture *rt,
+			     struct task_struct *task)
+{
+	struct sched_attr attr = {
+		.sched_policy = SCHED_FIFO,
+		.sched_priority = rt->prio,
+	};
+	int ret;
+
+	ret = sched_setattr_nocheck(task, &attr);
+	if (ret)
+		return ret;
+
+	if (rt->cpu < 0)
+		return 0;
+
+	return set_cpus_allowed_ptr(task, cpumask_of(rt->cpu));
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_set_sched, IIO_RT_CAPTURE);
+
+/**
+ * iio_rt_capture_start() - create the capture thread
+ * @rt: real-time capture state
+ * @dev: device the thread is named after
+ *
+ * Called when the buffer gets enabled, nothing is created if no real-time
+ * priority was requested.
+ *
+ * Return: 0 on success, negative error code otherwise
+ */
+int iio_rt_capture_start(struct iio_rt_capture *rt, struct device *dev)
+{
+	struct kthread_worker *worker;
+	int ret;
+
+	if (!rt->prio)
+		return 0;
+
+	worker = kthread_create_worker(0, "%s-capture", dev_name(dev));
+	if (IS_ERR(worker))
+		return PTR_ERR(worker);
+
+	ret = iio_rt_capture_set_sched(rt, worker->task);
+	if (ret) {
+		kthread_destroy_worker(worker);
+		return ret;
+	}
+
+	rt->worker = worker;
+
+	return 0;
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_start, IIO_RT_CAPTURE);
+
+/**
+ * iio_rt_capture_stop() - destroy the capture thread
+ * @rt: real-time capture state
+ *
+ * Called once the trigger is detached, the acquisition still queued is
+ * completed first.
+ */
+void iio_rt_capture_stop(struct iio_rt_capture *rt)
+{
+	if (!rt->worker)
+		return;
+
+	kthread_destroy_worker(rt->worker);
+	rt->worker = NULL;
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_stop, IIO_RT_CAPTURE);
+
+/* the attribute address holds the offset of the state inside iio_priv() */
+static struct iio_rt_capture *to_rt_capture(struct device *dev,
+					    struct device_attribute *attr)
+{
+	return iio_priv(dev_to_iio_dev(dev)) + to_iio_dev_attr(attr)->address;
+}
+
+ssize_t iio_rt_capture_prio_show(struct device *dev,
+				 struct device_attribute *attr, char *buf)
+{
+	return sysfs_emit(buf, "%u\n", to_rt_capture(dev, attr)->prio);
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_prio_show, IIO_RT_CAPTURE);
+
+ssize_t iio_rt_capture_prio_store(struct device *dev,
+				  struct device_attribute *attr,
+				  const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	u32 prio;
+	int ret;
+
+	ret = kstrtou32(buf, 0, &prio);
+	if (ret)
+		return ret;
+
+	if (prio >= MAX_RT_PRIO)
+		return -EINVAL;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	to_rt_capture(dev, attr)->prio = prio;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_prio_store, IIO_RT_CAPTURE);
+
+ssize_t iio_rt_capture_cpu_show(struct device *dev,
+				struct device_attribute *attr, char *buf)
+{
+	return sysfs_emit(buf, "%d\n", to_rt_capture(dev, attr)->cpu);
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_cpu_show, IIO_RT_CAPTURE);
+
+ssize_t iio_rt_capture_cpu_store(struct device *dev,
+				 struct device_attribute *attr,
+				 const char *buf, size_t len)
+{
+	struct iio_dev *indio_dev = dev_to_iio_dev(dev);
+	int cpu;
+	int ret;
+
+	ret = kstrtoint(buf, 0, &cpu);
+	if (ret)
+		return ret;
+
+	if (cpu < -1 || (cpu >= 0 && (cpu >= nr_cpu_ids || !cpu_online(cpu))))
+		return -EINVAL;
+
+	ret = iio_device_claim_direct_mode(indio_dev);
+	if (ret)
+		return ret;
+
+	to_rt_capture(dev, attr)->cpu = cpu;
+	iio_device_release_direct_mode(indio_dev);
+
+	return len;
+}
+EXPORT_SYMBOL_NS(iio_rt_capture_cpu_store, IIO_RT_CAPTURE);
+
+MODULE_AUTHOR("Petre Rodan <petre.rodan@subdimension.ro>");
+MODULE_DESCRIPTION("Real-time capture thread for IIO triggered buffers");
+MODULE_LICENSE("GPL");
@@ -0,0 +1,93 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Real-time capture thread shared by the triggered buffers of the pressure
+ * sensor drivers
+ *
+ * Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+ */
+
+#ifndef _IIO_RT_CAPTURE_H
+#define _IIO_RT_CAPTURE_H
+
+#include <linux/kthread.h>
+#include <linux/stddef.h>
+#include <linux/sysfs.h>
+#include <linux/types.h>
+
+#include <linux/iio/sysfs.h>
+
+struct device;
+struct device_attribute;
+struct iio_dev;
+struct task_struct;
+
+/**
+ * struct iio_rt_capture
+ * @prio: SCHED_FIFO priority of the capture thread, 0 if disabled
+ * @cpu: cpu the capture thread is bound to, -1 for any
+ * @worker: dedicated capture thread, present while a buffer is enabled with
+ *          a non-zero @prio
+ * @work: acquisition queued on @worker by the trigger
+ */
+struct iio_rt_capture {
+	u32 prio;
+	int cpu;
+	struct kthread_worker *worker;
+	struct kthread_work work;
+};
+
+void iio_rt_capture_init(struct iio_rt_capture *rt, kthread_work_func_t fn);
+int iio_rt_capture_set_sched(struct iio_rt_capture *rt,
+			     struct task_struct *task);
+int iio_rt_capture_start(struct iio_rt_capture *rt, struct device *dev);
+void iio_rt_capture_stop(struct iio_rt_capture *rt);
+
+ssize_t iio_rt_capture_prio_show(struct device *dev,
+				 struct device_attribute *attr, char *buf);
+ssize_t iio_rt_capture_prio_store(struct device *dev,
+				  struct device_attribute *attr,
+				  const char *buf, size_t len);
+ssize_t iio_rt_capture_cpu_show(struct device *dev,
+				struct device_attribute *attr, char *buf);
+ssize_t iio_rt_capture_cpu_store(struct device *dev,
+				 struct device_attribute *attr,
+				 const char *buf, size_t len);
+
+/**
+ * iio_rt_capture_queue() - hand the acquisition over to the capture thread
+ * @rt: real-time capture state
+ *
+ * Safe to call from the hard irq of the trigger.
+ *
+ * Return: true if the acquisition was queued, false if no capture thread is
+ * running and the caller has to do the acquisition itself
+ */
+static inline bool iio_rt_capture_queue(struct iio_rt_capture *rt)
+{
+	if (!rt->worker)
+		return false;
+
+	kthread_queue_work(rt->worker, &rt->work);
+
+	return true;
+}
+
+/*
+ * capture_rt_priority and capture_cpu device attributes of the struct
+ * iio_rt_capture found at @_member of the iio_priv() structure @_type
+ */
+#define IIO_RT_CAPTURE_DEVICE_ATTRS(_type, _member)			\
+	static IIO_DEVICE_ATTR(capture_rt_priority, 0644,		\
+			       iio_rt_capture_prio_show,		\
+			       iio_rt_capture_prio_store,		\
+			       offsetof(_type, _member));		\
+	static IIO_DEVICE_ATTR(capture_cpu, 0644,			\
+			       iio_rt_capture_cpu_show,			\
+			       iio_rt_capture_cpu_store,		\
+			       offsetof(_type, _member))
+
+#define IIO_RT_CAPTURE_ATTRS					\
+	&iio_dev_attr_capture_rt_priority.dev_attr.attr,		\
+	&iio_dev_attr_capture_cpu.dev_attr.attr
+
+#endif
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+insmod iio_rt_capture.ko
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+rmmod iio_rt_capture
@@ -0,0 +1,4 @@
+#!/bin/bash
+
+insmod pressure_aggregator.ko
+
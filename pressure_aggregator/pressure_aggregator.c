@@ -0,0 +1,444 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Virtual IIO device that aggregates the channels of several pressure sensors
+ * (hsc030pa, abp060mg, mprls0025pa) into a single synchronized scan
+ *
+ * Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+ */
+
+#include <linux/array_size.h>
+#include <linux/bitmap.h>
+#include <linux/bitops.h>
+#include <linux/device.h>
+#include <linux/err.h>
+#include <linux/limits.h>
+#include <linux/minmax.h>
+#include <linux/mod_devicetable.h>
+#include <linux/module.h>
+#include <linux/platform_device.h>
+#include <linux/property.h>
+#include <linux/slab.h>
+#include <linux/types.h>
+#include <linux/units.h>
+#include <linux/workqueue.h>
+
+#include <linux/iio/buffer.h>
+#include <linux/iio/consumer.h>
+#include <linux/iio/iio.h>
+#include <linux/iio/trigger_consumer.h>
+#include <linux/iio/triggered_buffer.h>
+
+#define AGGR_MAX_SOURCES 16
+#define AGGR_MAX_DIFFS   8
+
+/**
+ * struct aggr_diff - derived channel defined as minuend - subtrahend
+ * @minuend: index of the first source channel
+ * @subtrahend: index of the source channel that is subtracted
+ */
+struct aggr_diff {
+	u32 minuend;
+	u32 subtrahend;
+};
+
+/**
+ * struct aggr_read - read of one source, run concurrently with the others
+ * @work: runs the read on the unbound workqueue
+ * @source: consumer handle of the source channel
+ * @indio_dev: aggregator device, provides the timestamp clock
+ * @val: raw value read
+ * @ret: result of the read
+ * @start: time the read was started at
+ * @end: time the read completed at
+ */
+struct aggr_read {
+	struct work_struct work;
+	struct iio_channel *source;
+	struct iio_dev *indio_dev;
+	int val;
+	int ret;
+	s64 start;
+	s64 end;
+};
+
+/**
+ * struct aggr_data
+ * @dev: current device structure
+ * @sources: consumer handles of the aggregated channels
+ * @num_sources: number of aggregated channels
+ * @diffs: derived channels
+ * @num_diffs: number of derived channels
+ * @raw: raw value of each source channel acquired during the current scan
+ * @reads: concurrent reads of the source channels
+ * @scan: channel values for buffered mode
+ */
+struct aggr_data {
+	struct device *dev;
+	struct iio_channel *sources;
+	unsigned int num_sources;
+	struct aggr_diff diffs[AGGR_MAX_DIFFS];
+	unsigned int num_diffs;
+	int raw[AGGR_MAX_SOURCES];
+	struct aggr_read reads[AGGR_MAX_SOURCES];
+	struct {
+		s32 chan[AGGR_MAX_SOURCES + AGGR_MAX_DIFFS];
+		s64 timestamp __aligned(8);
+	} scan;
+};
+
+/*
+ * derived channels are provided in milli-pascal so that the difference between
+ * two low-range sensors (MPR0060MG, HSC2.5MD) keeps a useful resolution.
+ * IIO expects pressure in kPa, hence the 10^-6 scale.
+ */
+static int aggr_read_diff(struct aggr_data *data, unsigned int idx, s32 *val)
+{
+	const struct aggr_diff *diff = &data->diffs[idx];
+	int p1, p2;
+	int ret;
+
+	ret = iio_convert_raw_to_processed(&data->sources[diff->minuend],
+					   data->raw[diff->minuend], &p1, MICRO);
+	if (ret)
+		return ret;
+
+	ret = iio_convert_raw_to_processed(&data->sources[diff->subtrahend],
+					   data->raw[diff->subtrahend], &p2,
+					   MICRO);
+	if (ret)
+		return ret;
+
+	*val = p1 - p2;
+
+	return 0;
+}
+
+static void aggr_read_work(struct work_struct *work)
+{
+	struct aggr_read *r = container_of(work, struct aggr_read, work);
+
+	r->start = iio_get_time_ns(r->indio_dev);
+	r->ret = iio_read_channel_raw(r->source, &r->val);
+	r->end = iio_get_time_ns(r->indio_dev);
+}
+
+/*
+ * a read of a source is a whole blocking conversion (up to 10 ms on mpr), so
+ * the sources are read concurrently, each from its own worker. the
+ * conversions overlap and the values of a scan are taken within the duration
+ * of the slowest read plus the transfers of the other sensors that share its
+ * bus, instead of the sum of all the reads.
+ * @timestamp: set to the middle of the window the reads took place in,
+ *             optional
+ */
+static int aggr_read_sources(struct aggr_data *data, const unsigned long *mask,
+			     s64 *timestamp)
+{
+	s64 first = S64_MAX, last = S64_MIN;
+	struct aggr_read *r;
+	unsigned int i;
+	int ret = 0;
+
+	for_each_set_bit(i, mask, data->num_sources)
+		queue_work(system_unbound_wq, &data->reads[i].work);
+
+	for_each_set_bit(i, mask, data->num_sources) {
+		r = &data->reads[i];
+		flush_work(&r->work);
+		if (r->ret < 0 && !ret)
+			ret = r->ret;
+		data->raw[i] = r->val;
+		first = min(first, r->start);
+		last = max(last, r->end);
+	}
+
+	if (timestamp && first <= last)
+		*timestamp = first + (last - first) / 2;
+
+	return ret;
+}
+
+static irqreturn_t aggr_trigger_handler(int irq, void *private)
+{
+	struct iio_poll_func *pf = private;
+	struct iio_dev *indio_dev = pf->indio_dev;
+	struct aggr_data *data = iio_priv(indio_dev);
+	DECLARE_BITMAP(needed, AGGR_MAX_SOURCES);
+	const struct aggr_diff *diff;
+	unsigned int bit, i = 0;
+	s64 timestamp = pf->timestamp;
+	int ret;
+
+	/* a derived channel needs both its sources, even if not enabled */
+	bitmap_zero(needed, AGGR_MAX_SOURCES);
+	for_each_set_bit(bit, indio_dev->active_scan_mask,
+			 indio_dev->masklength) {
+		if (bit < data->num_sources) {
+			__set_bit(bit, needed);
+		} else if (bit < data->num_sources + data->num_diffs) {
+			diff = &data->diffs[bit - data->num_sources];
+			__set_bit(diff->minuend, needed);
+			__set_bit(diff->subtrahend, needed);
+		}
+	}
+
+	ret = aggr_read_sources(data, needed, &timestamp);
+	if (ret)
+		goto error;
+
+	for_each_set_bit(bit, indio_dev->active_scan_mask,
+			 indio_dev->masklength) {
+		if (bit < data->num_sources) {
+			data->scan.chan[i++] = data->raw[bit];
+		} else if (bit < data->num_sources + data->num_diffs) {
+			ret = aggr_read_diff(data, bit - data->num_sources,
+					     &data->scan.chan[i++]);
+			if (ret)
+				goto error;
+		}
+	}
+
+	/* one timestamp for all members, the middle of the read window */
+	iio_push_to_buffers_with_timestamp(indio_dev, &data->scan, timestamp);
+
+error:
+	iio_trigger_notify_done(indio_dev->trig);
+
+	return IRQ_HANDLED;
+}
+
+static int aggr_read_raw(struct iio_dev *indio_dev,
+			 struct iio_chan_spec const *chan, int *val,
+			 int *val2, long mask)
+{
+	struct aggr_data *data = iio_priv(indio_dev);
+	const struct aggr_diff *diff;
+	struct iio_channel *source;
+	DECLARE_BITMAP(needed, AGGR_MAX_SOURCES);
+	int ret;
+
+	if (chan->differential) {
+		diff = &data->diffs[chan->scan_index - data->num_sources];
+
+		switch (mask) {
+		case IIO_CHAN_INFO_RAW:
+			bitmap_zero(needed, AGGR_MAX_SOURCES);
+			__set_bit(diff->minuend, needed);
+			__set_bit(diff->subtrahend, needed);
+
+			ret = iio_device_claim_direct_mode(indio_dev);
+			if (ret)
+				return ret;
+
+			ret = aggr_read_sources(data, needed, NULL);
+			if (!ret)
+				ret = aggr_read_diff(data, chan->scan_index -
+						     data->num_sources, val);
+			iio_device_release_direct_mode(indio_dev);
+			if (ret)
+				return ret;
+
+			return IIO_VAL_INT;
+		case IIO_CHAN_INFO_SCALE:
+			*val = 0;
+			*val2 = 1000;
+			return IIO_VAL_INT_PLUS_NANO;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	source = &data->sources[chan->scan_index];
+
+	switch (mask) {
+	case IIO_CHAN_INFO_RAW:
+		return iio_read_channel_raw(source, val);
+	case IIO_CHAN_INFO_SCALE:
+		return iio_read_channel_scale(source, val, val2);
+	case IIO_CHAN_INFO_OFFSET:
+		return iio_read_channel_offset(source, val, val2);
+	default:
+		return -EINVAL;
+	}
+}
+
+static const struct iio_info aggr_info = {
+	.read_raw = aggr_read_raw,
+};
+
+static const struct iio_scan_type aggr_scan_type = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.endianness = IIO_CPU,
+};
+
+static int aggr_setup_channels(struct iio_dev *indio_dev)
+{
+	struct aggr_data *data = iio_priv(indio_dev);
+	const struct iio_chan_spec *src;
+	struct iio_chan_spec *chans, *chan;
+	unsigned int i, num_chans;
+
+	num_chans = data->num_sources + data->num_diffs + 1;
+	chans = devm_kcalloc(data->dev, num_chans, sizeof(*chans), GFP_KERNEL);
+	if (!chans)
+		return -ENOMEM;
+
+	for (i = 0; i < data->num_sources; i++) {
+		src = data->sources[i].channel;
+		chan = &chans[i];
+
+		chan->type = src->type;
+		chan->indexed = 1;
+		chan->channel = i;
+		chan->info_mask_separate = src->info_mask_separate &
+					   (BIT(IIO_CHAN_INFO_RAW) |
+					    BIT(IIO_CHAN_INFO_SCALE) |
+					    BIT(IIO_CHAN_INFO_OFFSET));
+		chan->scan_index = i;
+		chan->scan_type = aggr_scan_type;
+	}
+
+	for (i = 0; i < data->num_diffs; i++) {
+		chan = &chans[data->num_sources + i];
+
+		chan->type = IIO_PRESSURE;
+		chan->indexed = 1;
+		chan->differential = 1;
+		chan->channel = data->diffs[i].minuend;
+		chan->channel2 = data->diffs[i].subtrahend;
+		chan->info_mask_separate = BIT(IIO_CHAN_INFO_RAW) |
+					   BIT(IIO_CHAN_INFO_SCALE);
+		chan->scan_index = data->num_sources + i;
+		chan->scan_type = aggr_scan_type;
+	}
+
+	chans[num_chans - 1] = (struct iio_chan_spec)
+				IIO_CHAN_SOFT_TIMESTAMP(num_chans - 1);
+
+	indio_dev->channels = chans;
+	indio_dev->num_channels = num_chans;
+
+	return 0;
+}
+
+static int aggr_parse_diffs(struct aggr_data *data)
+{
+	struct device *dev = data->dev;
+	struct aggr_diff *diff;
+	u32 pairs[AGGR_MAX_DIFFS * 2];
+	unsigned int i;
+	int ret;
+
+	ret = device_property_count_u32(dev, "differential-channels");
+	if (ret == -EINVAL)
+		return 0;
+	if (ret < 0)
+		return dev_err_probe(dev, ret,
+			     "differential-channels could not be read\n");
+	if (!ret || ret % 2 || ret > ARRAY_SIZE(pairs))
+		return dev_err_probe(dev, -EINVAL,
+			     "differential-channels must hold up to %d pairs\n",
+			     AGGR_MAX_DIFFS);
+
+	data->num_diffs = ret / 2;
+	ret = device_property_read_u32_array(dev, "differential-channels",
+					     pairs, data->num_diffs * 2);
+	if (ret)
+		return dev_err_probe(dev, ret,
+			     "differential-channels could not be read\n");
+
+	for (i = 0; i < data->num_diffs; i++) {
+		diff = &data->diffs[i];
+		diff->minuend = pairs[2 * i];
+		diff->subtrahend = pairs[2 * i + 1];
+
+		if (diff->minuend >= data->num_sources ||
+		    diff->subtrahend >= data->num_sources ||
+		    diff->minuend == diff->subtrahend)
+			return dev_err_probe(dev, -EINVAL,
+				     "differential pair %u is invalid\n", i);
+
+		if (data->sources[diff->minuend].channel->type != IIO_PRESSURE ||
+		    data->sources[diff->subtrahend].channel->type != IIO_PRESSURE)
+			return dev_err_probe(dev, -EINVAL,
+				     "differential pair %u is not pressure\n", i);
+	}
+
+	return 0;
+}
+
+static int aggr_probe(struct platform_device *pdev)
+{
+	struct device *dev = &pdev->dev;
+	struct iio_dev *indio_dev;
+	struct aggr_data *data;
+	unsigned int i;
+	int ret;
+
+	indio_dev = devm_iio_device_alloc(dev, sizeof(*data));
+	if (!indio_dev)
+		return -ENOMEM;
+
+	data = iio_priv(indio_dev);
+	data->dev = dev;
+
+	data->sources = devm_iio_channel_get_all(dev);
+	if (IS_ERR(data->sources))
+		return dev_err_probe(dev, PTR_ERR(data->sources),
+				     "io-channels could not be acquired\n");
+
+	while (data->sources[data->num_sources].indio_dev)
+		data->num_sources++;
+
+	if (data->num_sources > AGGR_MAX_SOURCES)
+		return dev_err_probe(dev, -EINVAL,
+				     "at most %d io-channels are supported\n",
+				     AGGR_MAX_SOURCES);
+
+	for (i = 0; i < data->num_sources; i++) {
+		INIT_WORK(&data->reads[i].work, aggr_read_work);
+		data->reads[i].source = &data->sources[i];
+		data->reads[i].indio_dev = indio_dev;
+	}
+
+	ret = aggr_parse_diffs(data);
+	if (ret)
+		return ret;
+
+	ret = aggr_setup_channels(indio_dev);
+	if (ret)
+		return ret;
+
+	indio_dev->name = "pressure_aggregator";
+	indio_dev->modes = INDIO_DIRECT_MODE;
+	indio_dev->info = &aggr_info;
+
+	ret = devm_iio_triggered_buffer_setup(dev, indio_dev,
+					      iio_pollfunc_store_time,
+					      aggr_trigger_handler, NULL);
+	if (ret)
+		return ret;
+
+	return devm_iio_device_register(dev, indio_dev);
+}
+
+static const struct of_device_id aggr_match[] = {
+	{ .compatible = "iio-pressure-aggregator" },
+	{}
+};
+MODULE_DEVICE_TABLE(of, aggr_match);
+
+static struct platform_driver aggr_driver = {
+	.driver = {
+		.name = "pressure_aggregator",
+		.of_match_table = aggr_match,
+	},
+	.probe = aggr_probe,
+};
+module_platform_driver(aggr_driver);
+
+MODULE_AUTHOR("Petre Rodan <petre.rodan@subdimension.ro>");
+MODULE_DESCRIPTION("Synchronized scans from several pressure sensors");
+MODULE_LICENSE("GPL");
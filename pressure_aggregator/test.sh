@@ -0,0 +1,14 @@
+#!/bin/bash
+
+target='pressure_aggregator'
+
+rmmod "${target}" 2>/dev/null
+
+sleep 1
+
+insmod "${target}.ko"
+
+sleep 1
+
+iio_info
+
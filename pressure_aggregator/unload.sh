@@ -0,0 +1,4 @@
+#!/bin/bash
+
+rmmod pressure_aggregator
+
@@ -0,0 +1,416 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Sample interval distribution of an IIO triggered buffer, optionally
+ * measured while synthetic cpu, storage and network load is running
+ *
+ * Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+ */
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define IIO_DIR      "/sys/bus/iio/devices"
+#define MAX_WORKERS  64
+#define HIST_BUCKETS 24
+
+struct scan_layout {
+	unsigned int scan_bytes;
+	int ts_offset;
+};
+
+static int write_sysfs(const char *dir, const char *attr, const char *val)
+{
+	char path[512];
+	FILE *f;
+	int ret;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, attr);
+	f = fopen(path, "w");
+	if (!f)
+		return -errno;
+
+	ret = fprintf(f, "%s", val) < 0 ? -EIO : 0;
+	if (fclose(f))
+		ret = -errno;
+
+	return ret;
+}
+
+static int read_sysfs(const char *dir, const char *attr, char *val, size_t len)
+{
+	char path[512];
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/%s", dir, attr);
+	f = fopen(path, "r");
+	if (!f)
+		return -errno;
+
+	if (!fgets(val, len, f)) {
+		fclose(f);
+		return -EIO;
+	}
+	fclose(f);
+	val[strcspn(val, "\n")] = 0;
+
+	return 0;
+}
+
+/*
+ * enable every scan element and compute the scan size and the offset of the
+ * timestamp, following the IIO rule that each element is naturally aligned
+ */
+static int setup_scan(const char *devdir, struct scan_layout *layout)
+{
+	struct {
+		unsigned int index;
+		unsigned int bytes;
+		int is_ts;
+	} elem[32];
+	char scandir[512], attr[300], val[64];
+	unsigned int n = 0, i, j, offset = 0, max_bytes = 1;
+	struct dirent *ent;
+	DIR *d;
+
+	snprintf(scandir, sizeof(scandir), "%s/scan_elements", devdir);
+	d = opendir(scandir);
+	if (!d)
+		return -errno;
+
+	while ((ent = readdir(d)) && n < 32) {
+		size_t len = strlen(ent->d_name);
+		unsigned int bits;
+
+		if (len < 4 || strcmp(ent->d_name + len - 3, "_en"))
+			continue;
+
+		if (write_sysfs(scandir, ent->d_name, "1"))
+			continue;
+
+		snprintf(attr, sizeof(attr), "%.*s_index", (int)len - 3,
+			 ent->d_name);
+		if (read_sysfs(scandir, attr, val, sizeof(val)))
+			continue;
+		elem[n].index = strtoul(val, NULL, 0);
+
+		snprintf(attr, sizeof(attr), "%.*s_type", (int)len - 3,
+			 ent->d_name);
+		if (read_sysfs(scandir, attr, val, sizeof(val)) ||
+		    !strchr(val, '/'))
+			continue;
+		bits = strtoul(strchr(val, '/') + 1, NULL, 0);
+		elem[n].bytes = bits / 8;
+		if (!elem[n].bytes)
+			continue;
+		elem[n].is_ts = !strncmp(ent->d_name, "in_timestamp", 12);
+		n++;
+	}
+	closedir(d);
+
+	/* scan elements are stored in the order of their index */
+	for (i = 1; i < n; i++)
+		for (j = i; j > 0 && elem[j - 1].index > elem[j].index; j--) {
+			typeof(elem[0]) tmp = elem[j];
+
+			elem[j] = elem[j - 1];
+			elem[j - 1] = tmp;
+		}
+
+	layout->ts_offset = -1;
+	for (i = 0; i < n; i++) {
+		if (offset % elem[i].bytes)
+			offset += elem[i].bytes - offset % elem[i].bytes;
+		if (elem[i].is_ts)
+			layout->ts_offset = offset;
+		offset += elem[i].bytes;
+		if (elem[i].bytes > max_bytes)
+			max_bytes = elem[i].bytes;
+	}
+	if (offset % max_bytes)
+		offset += max_bytes - offset % max_bytes;
+	layout->scan_bytes = offset;
+
+	return layout->ts_offset < 0 ? -ENOENT : 0;
+}
+
+static void load_cpu(void)
+{
+	volatile uint64_t x = 0;
+
+	for (;;)
+		x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+}
+
+static void load_storage(void)
+{
+	char name[] = "/tmp/iio_bench_XXXXXX";
+	static char block[1 << 20];
+	int fd;
+
+	fd = mkstemp(name);
+	if (fd < 0)
+		_exit(1);
+	unlink(name);
+	memset(block, 0x5a, sizeof(block));
+
+	for (;;) {
+		if (write(fd, block, sizeof(block)) < 0 || fsync(fd) ||
+		    lseek(fd, 0, SEEK_SET) < 0)
+			_exit(1);
+	}
+}
+
+static void load_network(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(9),
+	};
+	static char pkt[1400];
+	int fd;
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0)
+		_exit(1);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	for (;;)
+		sendto(fd, pkt, sizeof(pkt), 0, (struct sockaddr *)&addr,
+		       sizeof(addr));
+}
+
+static int start_load(unsigned int workers, pid_t *pids)
+{
+	static void (* const loads[])(void) = {
+		load_cpu, load_storage, load_network,
+	};
+	unsigned int i;
+
+	for (i = 0; i < workers; i++) {
+		pids[i] = fork();
+		if (pids[i] < 0)
+			return -errno;
+		if (!pids[i]) {
+			loads[i % 3]();
+			_exit(0);
+		}
+	}
+
+	return 0;
+}
+
+static void stop_load(unsigned int workers, pid_t *pids)
+{
+	unsigned int i;
+
+	for (i = 0; i < workers; i++) {
+		if (pids[i] > 0) {
+			kill(pids[i], SIGKILL);
+			waitpid(pids[i], NULL, 0);
+		}
+	}
+}
+
+static int cmp_s64(const void *a, const void *b)
+{
+	int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(int64_t *intervals, size_t n)
+{
+	static const double pct[] = { 50, 90, 99, 99.9, 99.99 };
+	size_t hist[HIST_BUCKETS] = { 0 };
+	double mean = 0, var = 0;
+	size_t i;
+	int b;
+
+	qsort(intervals, n, sizeof(*intervals), cmp_s64);
+
+	for (i = 0; i < n; i++)
+		mean += intervals[i];
+	mean /= n;
+	for (i = 0; i < n; i++)
+		var += (intervals[i] - mean) * (intervals[i] - mean);
+	var /= n;
+
+	printf("intervals   %zu\n", n);
+	printf("min         %.3f us\n", intervals[0] / 1e3);
+	printf("mean        %.3f us\n", mean / 1e3);
+	printf("stddev      %.3f us\n", sqrt(var) / 1e3);
+	for (i = 0; i < sizeof(pct) / sizeof(pct[0]); i++)
+		printf("p%-10g %.3f us\n", pct[i],
+		       intervals[(size_t)((n - 1) * pct[i] / 100)] / 1e3);
+	printf("max         %.3f us\n", intervals[n - 1] / 1e3);
+
+	/* deviation from the median, in power of two microsecond buckets */
+	for (i = 0; i < n; i++) {
+		int64_t dev = llabs(intervals[i] - intervals[(n - 1) / 2]) / 1000;
+
+		for (b = 0; b < HIST_BUCKETS - 1 && dev >= (1LL << b); b++)
+			;
+		hist[b]++;
+	}
+
+	printf("\n|interval - median|   count\n");
+	for (b = 0; b < HIST_BUCKETS; b++) {
+		if (!hist[b])
+			continue;
+		if (!b)
+			printf("       < 1 us      %zu\n", hist[b]);
+		else
+			printf("  < %8lld us      %zu\n", 1LL << b, hist[b]);
+	}
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s -d DEV [-n SAMPLES] [-t TRIGGER] [-l WORKERS] [-p PRIO] [-c CPU]\n"
+		"  -d DEV      iio device number (iio:deviceDEV)\n"
+		"  -n SAMPLES  number of scans to capture (default 10000)\n"
+		"  -t TRIGGER  trigger to attach to the device\n"
+		"  -l WORKERS  background load processes, cycling through cpu,\n"
+		"              storage and network load (default 0)\n"
+		"  -p PRIO     value written to capture_rt_priority\n"
+		"  -c CPU      value written to capture_cpu\n", name);
+}
+
+int main(int argc, char **argv)
+{
+	const char *trigger = NULL, *prio = NULL, *cpu = NULL;
+	unsigned int samples = 10000, workers = 0, got = 0;
+	pid_t pids[MAX_WORKERS] = { 0 };
+	char devdir[256], chrdev[64];
+	struct scan_layout layout = { 0 };
+	int64_t *intervals, ts, prev_ts = 0;
+	uint8_t *scan;
+	int dev = -1;
+	int fd, opt, ret;
+
+	while ((opt = getopt(argc, argv, "d:n:t:l:p:c:h")) != -1) {
+		switch (opt) {
+		case 'd':
+			dev = atoi(optarg);
+			break;
+		case 'n':
+			samples = strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			trigger = optarg;
+			break;
+		case 'l':
+			workers = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			prio = optarg;
+			break;
+		case 'c':
+			cpu = optarg;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (dev < 0 || samples < 2 || workers > MAX_WORKERS) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	snprintf(devdir, sizeof(devdir), IIO_DIR "/iio:device%d", dev);
+	snprintf(chrdev, sizeof(chrdev), "/dev/iio:device%d", dev);
+
+	write_sysfs(devdir, "buffer/enable", "0");
+
+	if ((prio && write_sysfs(devdir, "capture_rt_priority", prio)) ||
+	    (cpu && write_sysfs(devdir, "capture_cpu", cpu))) {
+		fprintf(stderr, "unable to configure the capture thread\n");
+		return 1;
+	}
+
+	if (trigger && write_sysfs(devdir, "trigger/current_trigger", trigger)) {
+		fprintf(stderr, "unable to set trigger %s\n", trigger);
+		return 1;
+	}
+
+	ret = setup_scan(devdir, &layout);
+	if (ret) {
+		fprintf(stderr, "timestamp channel not available: %s\n",
+			strerror(-ret));
+		return 1;
+	}
+
+	intervals = calloc(samples, sizeof(*intervals));
+	scan = calloc(1, layout.scan_bytes);
+	if (!intervals || !scan)
+		return 1;
+
+	if (start_load(workers, pids)) {
+		stop_load(workers, pids);
+		fprintf(stderr, "unable to start the background load\n");
+		return 1;
+	}
+
+	write_sysfs(devdir, "buffer/length", "128");
+	if (write_sysfs(devdir, "buffer/enable", "1")) {
+		stop_load(workers, pids);
+		fprintf(stderr, "unable to enable the buffer\n");
+		return 1;
+	}
+
+	fd = open(chrdev, O_RDONLY);
+	if (fd < 0) {
+		ret = 1;
+		goto out;
+	}
+
+	while (got < samples) {
+		ret = read(fd, scan, layout.scan_bytes);
+		if (ret < 0 && errno == EINTR)
+			continue;
+		if (ret != (int)layout.scan_bytes) {
+			fprintf(stderr, "short read\n");
+			break;
+		}
+
+		memcpy(&ts, scan + layout.ts_offset, sizeof(ts));
+		if (prev_ts)
+			intervals[got++] = ts - prev_ts;
+		prev_ts = ts;
+	}
+	close(fd);
+	ret = 0;
+
+out:
+	write_sysfs(devdir, "buffer/enable", "0");
+	stop_load(workers, pids);
+
+	if (got > 1) {
+		printf("device      iio:device%d\n", dev);
+		printf("load        %u workers\n", workers);
+		report(intervals, got);
+	}
+
+	free(scan);
+	free(intervals);
+
+	return ret;
+}
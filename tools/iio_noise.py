@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# Noise and stability characterization of the pressure channel delivered by
+# the hsc030pa, abp060mg and mprls0025pa drivers.
+#
+# For every combination of sampling frequency and oversampling ratio the
+# pressure channel is captured through the IIO buffer and the tool reports
+# the standard deviation, the Allan deviation and a Welch power spectral
+# density. The combination that provides the lowest noise per unit of bus
+# time is recommended.
+#
+# The --emulate mode replaces the sensor with a deterministic software model
+# so that the analysis itself can be verified against the reference results
+# found in tools/reference/.
+#
+# Copyright (c) 2024 Petre Rodan <petre.rodan@subdimension.ro>
+
+import argparse
+import cmath
+import math
+import os
+import random
+import struct
+import sys
+
+IIO_DIR = '/sys/bus/iio/devices'
+PSD_NFFT = 256
+
+# bus time needed for one raw sample, 100 kHz I2C without clock stretching:
+#  hsc, abp - address byte + 4 data bytes
+#  mpr      - 3 byte measurement command + address byte + 4 data bytes
+BUS_TIME_S = {
+    'hsc': 5 * 9 / 100e3,
+    'abp': 5 * 9 / 100e3,
+    'mpr': 9 * 9 / 100e3,
+}
+
+# sensor models used by --emulate
+#  rate   - internal conversion rate [Hz]
+#  white  - white noise of one conversion [counts rms]
+#  walk   - random walk increment per second [counts]
+#  hum    - amplitude of the mains pickup [counts]
+EMULATED = {
+    'hsc': {'rate': 2170.0, 'white': 1.6, 'walk': 0.35, 'hum': 0.8},
+    'abp': {'rate': 2170.0, 'white': 2.2, 'walk': 0.5, 'hum': 1.0},
+    'mpr': {'rate': 180.0, 'white': 45.0, 'walk': 20.0, 'hum': 0.0},
+}
+HUM_HZ = 50.0
+
+
+def fmt(val):
+    return '%.4g' % val
+
+
+def decimate(samples, osr):
+    """software averaging for parts without hardware oversampling"""
+    return [sum(samples[i:i + osr]) / osr
+            for i in range(0, len(samples) - osr + 1, osr)]
+
+
+class Emulator:
+    """sensor that updates its output at a fixed internal rate. like on the
+    real parts only mpr has hardware oversampling, applied as back-to-back
+    conversions, the others get averaged in user-space"""
+
+    def __init__(self, family, seed):
+        self.model = EMULATED[family]
+        self.rng = random.Random(seed)
+        self.hw_osr = family == 'mpr'
+
+    def capture(self, freq, osr, duration):
+        """returns (samples, odr), samples are in counts of one conversion"""
+        m = self.model
+        steps = osr if self.hw_osr else 1
+        walk = 0.0
+        conv_idx = -1
+        conv_val = 0.0
+        samples = []
+        walk_step = m['walk'] / math.sqrt(m['rate'])
+
+        for i in range(int(freq * duration)):
+            t = i / freq
+            acc = 0.0
+            for _ in range(steps):
+                # a read returns the latest conversion, hardware
+                # oversampling needs a fresh conversion for every step
+                idx = int(t * m['rate'])
+                while conv_idx < idx:
+                    conv_idx += 1
+                    walk += self.rng.gauss(0.0, walk_step)
+                    conv_val = (8192.0 + walk +
+                                self.rng.gauss(0.0, m['white']) +
+                                m['hum'] * math.sin(2 * math.pi * HUM_HZ *
+                                                    conv_idx / m['rate']))
+                acc += round(conv_val)
+                t += 1.0 / m['rate']
+            samples.append(acc / steps)
+
+        if self.hw_osr or osr == 1:
+            return samples, freq
+
+        return decimate(samples, osr), freq / osr
+
+
+class Device:
+    """pressure channel of an IIO device captured via its buffer"""
+
+    def __init__(self, dev, trigger):
+        self.dir = os.path.join(IIO_DIR, 'iio:device%d' % dev)
+        self.chrdev = '/dev/iio:device%d' % dev
+        self.trigger = trigger
+        self.hw_osr = os.path.exists(os.path.join(
+            self.dir, 'in_pressure_oversampling_ratio'))
+
+    def _write(self, attr, val):
+        with open(os.path.join(self.dir, attr), 'w') as f:
+            f.write(str(val))
+
+    def _read(self, attr):
+        with open(os.path.join(self.dir, attr)) as f:
+            return f.read().strip()
+
+    def _layout(self):
+        scan = os.path.join(self.dir, 'scan_elements')
+        for name in os.listdir(scan):
+            if name.endswith('_en'):
+                want = name in ('in_pressure_en', 'in_timestamp_en')
+                self._write(os.path.join('scan_elements', name), int(want))
+
+        ptype = self._read('scan_elements/in_pressure_type')
+        endian, rest = ptype.split(':')
+        sign = rest[0]
+        realbits = int(rest[1:].split('/')[0])
+        storage = int(rest.split('/')[1].split('>>')[0])
+        shift = int(rest.split('>>')[1])
+        fmtc = {8: 'b', 16: 'h', 32: 'i', 64: 'q'}[storage]
+        if sign == 'u':
+            fmtc = fmtc.upper()
+        fmtc = ('>' if endian == 'be' else '<') + fmtc
+        scan_bytes = (storage // 8 + 7) // 8 * 8 + 8
+
+        return fmtc, realbits, shift, scan_bytes
+
+    def capture(self, freq, osr, duration):
+        """returns (samples, odr), samples are in counts of one conversion"""
+        trig = os.path.join(IIO_DIR, self.trigger, 'sampling_frequency')
+        with open(trig, 'w') as f:
+            f.write(str(freq))
+
+        self._write('buffer/enable', 0)
+        with open(os.path.join(IIO_DIR, self.trigger, 'name')) as f:
+            self._write('trigger/current_trigger', f.read().strip())
+        if self.hw_osr:
+            self._write('in_pressure_oversampling_ratio', osr)
+        fmtc, realbits, shift, scan_bytes = self._layout()
+        mask = (1 << realbits) - 1
+        want = int(freq * duration)
+
+        samples = []
+        self._write('buffer/length', 256)
+        self._write('buffer/enable', 1)
+        try:
+            with open(self.chrdev, 'rb', buffering=0) as f:
+                while len(samples) < want:
+                    buf = f.read(scan_bytes)
+                    if len(buf) != scan_bytes:
+                        raise IOError('short read from %s' % self.chrdev)
+                    raw = struct.unpack_from(fmtc, buf)[0]
+                    samples.append(float((raw >> shift) & mask))
+        finally:
+            self._write('buffer/enable', 0)
+
+        # hardware oversampling delivers one sample per trigger holding the
+        # sum of the conversions, the scale of the channel accounts for it
+        if self.hw_osr:
+            return [v / osr for v in samples], freq
+
+        if osr == 1:
+            return samples, freq
+
+        return decimate(samples, osr), freq / osr
+
+
+def stddev(x):
+    mean = sum(x) / len(x)
+    return math.sqrt(sum((v - mean) ** 2 for v in x) / (len(x) - 1))
+
+
+def allan_deviation(x, rate):
+    """non-overlapping Allan deviation for octave spaced averaging times"""
+    result = []
+    m = 1
+    while len(x) // m >= 8:
+        avg = [sum(x[i:i + m]) / m for i in range(0, len(x) - m + 1, m)]
+        diff = [(avg[i + 1] - avg[i]) ** 2 for i in range(len(avg) - 1)]
+        result.append((m / rate, math.sqrt(sum(diff) / (2 * len(diff)))))
+        m *= 2
+
+    return result
+
+
+def fft(x):
+    n = len(x)
+    if n == 1:
+        return list(x)
+    even = fft(x[0::2])
+    odd = fft(x[1::2])
+    tw = [cmath.exp(-2j * math.pi * k / n) * odd[k] for k in range(n // 2)]
+
+    return ([even[k] + tw[k] for k in range(n // 2)] +
+            [even[k] - tw[k] for k in range(n // 2)])
+
+
+def welch_psd(x, rate, nfft=PSD_NFFT):
+    """one-sided power spectral density [counts^2/Hz], Hann window"""
+    nfft = min(nfft, 1 << int(math.log2(len(x))))
+    win = [0.5 - 0.5 * math.cos(2 * math.pi * i / nfft) for i in range(nfft)]
+    wpow = sum(w * w for w in win)
+    psd = [0.0] * (nfft // 2 + 1)
+    segments = 0
+
+    for start in range(0, len(x) - nfft + 1, nfft // 2):
+        seg = x[start:start + nfft]
+        mean = sum(seg) / nfft
+        spec = fft([(v - mean) * w for v, w in zip(seg, win)])
+        for k in range(nfft // 2 + 1):
+            p = abs(spec[k]) ** 2 / (rate * wpow)
+            psd[k] += p if k in (0, nfft // 2) else 2 * p
+        segments += 1
+
+    return [(k * rate / nfft, p / segments) for k, p in enumerate(psd)]
+
+
+def analyze(samples, rate, bus_time):
+    psd = welch_psd(samples, rate)
+    # noise floor is the median density, DC excluded
+    dens = sorted(p for f, p in psd[1:])
+    floor = dens[len(dens) // 2]
+    peak_f, peak_p = max(psd[1:], key=lambda fp: fp[1])
+    sigma = stddev(samples)
+
+    return {
+        'sigma': sigma,
+        'adev': allan_deviation(samples, rate),
+        'floor': math.sqrt(floor),
+        'peak_f': peak_f,
+        'peak': math.sqrt(peak_p),
+        'fom': sigma * math.sqrt(bus_time),
+    }
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument('-d', '--device', type=int,
+                     help='iio device number')
+    src.add_argument('--emulate', choices=sorted(EMULATED),
+                     help='use a software model of the sensor family')
+    ap.add_argument('-t', '--trigger', default='trigger0',
+                    help='trigger driving the capture (default trigger0)')
+    ap.add_argument('-f', '--family', choices=sorted(BUS_TIME_S),
+                    default='hsc', help='sensor family (bus time model)')
+    ap.add_argument('-r', '--rates', default='25,50,100,200',
+                    help='sampling frequencies to sweep [Hz]')
+    ap.add_argument('-o', '--osr', default='1,2,4,8',
+                    help='oversampling ratios to sweep')
+    ap.add_argument('-T', '--duration', type=float, default=20.0,
+                    help='capture length for each combination [s]')
+    ap.add_argument('-m', '--min-rate', type=float, default=10.0,
+                    help='lowest acceptable output data rate [Hz]')
+    ap.add_argument('--seed', type=int, default=1,
+                    help='random seed for --emulate')
+    ap.add_argument('--check', metavar='FILE',
+                    help='compare the report against a reference file')
+    args = ap.parse_args()
+
+    if args.emulate:
+        args.family = args.emulate
+        sensor = Emulator(args.emulate, args.seed)
+    else:
+        sensor = Device(args.device, args.trigger)
+
+    rates = [float(r) for r in args.rates.split(',')]
+    ratios = [int(o) for o in args.osr.split(',')]
+    out = []
+    results = []
+
+    out.append('family %s, %s s per combination' %
+               (args.family, fmt(args.duration)))
+    out.append('')
+    out.append('%10s %4s %10s %10s %12s %12s %10s %12s' %
+               ('freq[Hz]', 'osr', 'odr[Hz]', 'sigma', 'floor/rtHz',
+                'peak[Hz]', 'peak', 'sigma*rt(tb)'))
+
+    for freq in rates:
+        for osr in ratios:
+            samples, odr = sensor.capture(freq, osr, args.duration)
+            if len(samples) < 2 * PSD_NFFT:
+                continue
+            bus_time = osr * BUS_TIME_S[args.family]
+            res = analyze(samples, odr, bus_time)
+            res.update(freq=freq, osr=osr, odr=odr)
+            results.append(res)
+            out.append('%10s %4d %10s %10s %12s %12s %10s %12s' %
+                       (fmt(freq), osr, fmt(odr), fmt(res['sigma']),
+                        fmt(res['floor']), fmt(res['peak_f']),
+                        fmt(res['peak']), fmt(res['fom'])))
+
+    candidates = [r for r in results if r['odr'] >= args.min_rate]
+    if candidates:
+        best = min(candidates, key=lambda r: (r['fom'], r['freq'] * r['osr']))
+        out.append('')
+        out.append('Allan deviation for sampling_frequency %s, '
+                   'oversampling_ratio %d' % (fmt(best['freq']), best['osr']))
+        out.append('%12s %12s' % ('tau[s]', 'adev'))
+        for tau, adev in best['adev']:
+            out.append('%12s %12s' % (fmt(tau), fmt(adev)))
+        out.append('')
+        out.append('recommended: sampling_frequency %s, oversampling_ratio %d'
+                   % (fmt(best['freq']), best['osr']))
+    else:
+        out.append('')
+        out.append('no combination reaches an output data rate of %s Hz'
+                   % fmt(args.min_rate))
+
+    report = '\n'.join(out) + '\n'
+    sys.stdout.write(report)
+
+    if args.check:
+        with open(args.check) as f:
+            if f.read() != report:
+                sys.stderr.write('report differs from %s\n' % args.check)
+                return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())